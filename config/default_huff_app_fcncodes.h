@@ -37,7 +37,20 @@
 */
 #define HUFF_APP_NOOP_CC           0
 #define HUFF_APP_RESET_COUNTERS_CC 1
-//#define HUFF_APP_PROCESS_CC        2
-//#define HUFF_APP_DISPLAY_PARAM_CC  3
+#define HUFF_APP_CONTEND_CC        2
+#define HUFF_APP_CALIBRATE_CC      3
+#define HUFF_APP_SET_GUARD_CC      4
+#define HUFF_APP_LOAD_CORPUS_CC    5
+#define HUFF_APP_GENERATE_CC       6
+#define HUFF_APP_SWEEP_CC          7
+#define HUFF_APP_PAR_DECODE_CC     8
+#define HUFF_APP_CANCEL_CC         9
+#define HUFF_APP_TRACE_DUMP_CC     10
+#define HUFF_APP_PERF_CAPTURE_CC   11
+#define HUFF_APP_BATCH_CC          12
+#define HUFF_APP_REPLAY_CC         13
+#define HUFF_APP_AB_COMPARE_CC     14
+#define HUFF_APP_ADAPTIVE_RUN_CC   15
+#define HUFF_APP_DISPATCH_STATS_CC 16
 
 #endif
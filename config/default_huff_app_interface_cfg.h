@@ -41,4 +41,77 @@
  */
 #define HUFF_APP_STRING_VAL_LEN 64
 
+/**
+ * \brief Length of the formatted result string in the result telemetry
+ *
+ * Result sentences ("$HUNU,...*CS") are built in a buffer of this size
+ * and copied as a whole into the result telemetry packet.
+ */
+#define HUFF_APP_RESULT_STR_LEN 128
+
+/**
+ * \brief Length of file name parameters in commands
+ */
+#define HUFF_APP_FILENAME_LEN 64
+
+/**
+ * \brief Number of symbols of the in-app Huffman codec
+ *
+ * The codec works on byte symbols.
+ */
+#define HUFF_APP_CODEC_SYMBOLS 256
+
+/**
+ * \brief Maximum code length of the in-app Huffman codec, in bits
+ *
+ * Code books are length-limited so that every symbol is decoded with a
+ * single lookup in a table of 2^HUFF_APP_CODEC_MAX_CODE_LEN entries.
+ * Must not exceed 15.
+ */
+#define HUFF_APP_CODEC_MAX_CODE_LEN 12
+
+/**
+ * \brief Number of code books in the code book table
+ *
+ * Code book table entry i is served as decode service book ID i + 1.
+ */
+#define HUFF_APP_TBL_MAX_BOOKS 3
+
+/**
+ * \brief Largest encoded block accepted in one decode service request
+ */
+#define HUFF_APP_DECODE_MAX_ENC_BYTES 1024
+
+/**
+ * \brief Largest number of symbols returned in one decode service response
+ */
+#define HUFF_APP_DECODE_MAX_SYMBOLS 2048
+
+/**
+ * \brief Number of decode service clients with their own housekeeping counters
+ */
+#define HUFF_APP_DECODE_MAX_CLIENTS 4
+
+/**
+ * \brief Number of parallel decode workers, the app main task included
+ *
+ * Each worker has its own housekeeping counters.
+ */
+#define HUFF_APP_PARDEC_MAX_WORKERS 4
+
+/**
+ * \brief Number of telemetry MIDs the compression service can subscribe to
+ */
+#define HUFF_APP_TLMC_MAX_MIDS 8
+
+/**
+ * \brief Number of build configurations with a stored performance baseline
+ */
+#define HUFF_APP_BASELINE_MAX_ENTRIES 8
+
+/**
+ * \brief Largest telemetry payload the compression service accepts, in bytes
+ */
+#define HUFF_APP_TLMC_MAX_PAYLOAD 1024
+
 #endif
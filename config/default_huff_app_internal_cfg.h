@@ -35,10 +35,159 @@
 /***********************************************************************/
 #define HUFF_APP_PIPE_DEPTH 32 /* Depth of the Command Pipe for Application */
 
-#define HUFF_APP_NUMBER_OF_TABLES 1 /* Number of Example Table(s) */
+#define HUFF_APP_NUMBER_OF_TABLES 1 /* Number of Code Book Table(s) */
 
 #define HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE -1
 
-#define HUFF_APP_TBL_ELEMENT_1_MAX 10
+/*
+** Background interference generator (contended runs)
+*/
+#define HUFF_APP_INTERF_MAX_TASKS     4          /* Maximum number of interference child tasks */
+#ifdef __linux__
+#define HUFF_APP_INTERF_BUFFER_SIZE   (2 << 20)  /* Bytes per task; should exceed the target LLC */
+#else
+#define HUFF_APP_INTERF_BUFFER_SIZE   (512 << 10) /* Sized for the RAM and L2 cache of the flight target */
+#endif
+#define HUFF_APP_INTERF_STACK_SIZE    8192       /* Stack size of each interference task */
+#define HUFF_APP_INTERF_PRIORITY      250        /* Low priority, so interference only uses idle time */
+#define HUFF_APP_INTERF_WARMUP_MS     20         /* Delay between starting interference and timing */
+#define HUFF_APP_INTERF_STOP_TIMEOUT  1000       /* Time allowed for the tasks to exit, in ms */
+
+#define HUFF_APP_CONTEND_MAX_RUNS     1000       /* Maximum benchmark runs per contended phase */
+
+/*
+** Iteration count calibration
+*/
+#define HUFF_APP_CALIB_MIN_SAMPLE_US  10000      /* Default minimum duration of one timed sample */
+#define HUFF_APP_CALIB_MAX_ITERATIONS 65536      /* Upper bound of the calibrated iteration count */
+#define HUFF_APP_BENCH_TASK_BYTES     1024       /* Output bytes of one bench_lib invocation, for the HK throughput */
+
+/*
+** CPU frequency stability guard
+*/
+#define HUFF_APP_GUARD_LOOP_ITERATIONS     250000 /* Length of the fixed loop timed around each sample */
+#define HUFF_APP_GUARD_CYCLES_PER_ITERATION 4     /* Estimated cycles of one loop iteration (multiply + add) */
+#define HUFF_APP_GUARD_DEFAULT_TOLERANCE   50     /* Default allowed loop time drift, in permille */
+#define HUFF_APP_GUARD_MAX_RETRIES         3      /* Samples retried in reject mode before giving up */
+
+/*
+** In-app decode workloads (corpus and generated inputs)
+**
+** The source, output and worst case encoded buffers are static, 3.5 times
+** this size in all. Larger corpus files are truncated to it.
+*/
+#ifdef __linux__
+#define HUFF_APP_WORKLOAD_MAX_BYTES   (16 << 20) /* Larger than the L3 cache of the benchmark hosts */
+#else
+#define HUFF_APP_WORKLOAD_MAX_BYTES   (1 << 20)  /* Sized for the RAM of the flight target */
+#endif
+#define HUFF_APP_WORKLOAD_BLOCK_SYMBOLS 4096     /* Symbols between two entries of the block index */
+
+/*
+** Pipelined input generation (generated inputs renewed on every run)
+*/
+#ifdef __linux__
+#define HUFF_APP_GENPIPE_MAX_BYTES    (4 << 20)  /* Largest input of each of the two pipeline buffers */
+#else
+#define HUFF_APP_GENPIPE_MAX_BYTES    (256 << 10) /* Two buffers, so a quarter of the workload maximum */
+#endif
+#define HUFF_APP_GENPIPE_STACK_SIZE   8192       /* Stack size of the generator task */
+#define HUFF_APP_GENPIPE_PRIORITY     90         /* Below the executor, so it never delays a timed decode */
+#define HUFF_APP_GENPIPE_WAIT_TIMEOUT 10000      /* Time a run waits for its input, in ms */
+
+/*
+** Benchmark executor
+*/
+#define HUFF_APP_EXEC_QUEUE_DEPTH     8          /* Benchmark commands held, the running one included */
+#define HUFF_APP_EXEC_STACK_SIZE      16384      /* Stack size of the executor task */
+#define HUFF_APP_EXEC_PRIORITY        80         /* Below the app main task, so HK and commands go first */
+#define HUFF_APP_EXEC_DUMP_BURST      16         /* Result sentences a dump sends back to back */
+#define HUFF_APP_EXEC_DUMP_PAUSE_MS   100        /* Pause between two bursts, so the telemetry output keeps up */
+
+/*
+** Parallel decode of the block index
+*/
+#define HUFF_APP_PARDEC_CHUNK_BLOCKS  4          /* Index blocks per work-stealing chunk */
+#define HUFF_APP_PARDEC_STACK_SIZE    8192       /* Stack size of each worker task */
+#define HUFF_APP_PARDEC_PRIORITY      HUFF_APP_EXEC_PRIORITY /* Same as the executor, which decodes too */
+
+/*
+** Phase trace recorder
+*/
+#ifdef __linux__
+#define HUFF_APP_TRACE_EVENTS         4096       /* Events per task ring, a power of two; 0 compiles tracing out */
+#else
+#define HUFF_APP_TRACE_EVENTS         1024       /* Sized for the RAM of the flight target */
+#endif
+#define HUFF_APP_TRACE_MAX_TASKS      8          /* Rings: main, executor, service, generator, decode workers */
+#define HUFF_APP_TRACE_DEFAULT_FILE   "/ram/huff_trace" /* Dump file when none is given, .json or .bin added */
+
+/*
+** CFE_ES performance log captures
+*/
+#define HUFF_APP_PERFCAP_MAX_RUNS     1000       /* Maximum benchmark runs per capture */
+#define HUFF_APP_PERFCAP_SETTLE_MS    50         /* Time given to ES to act on a perf command */
+
+/*
+** Baseline comparison of benchmark batches
+*/
+#define HUFF_APP_BATCH_MAX_RUNS       256        /* Maximum samples per batch */
+
+/*
+** Seed replay log
+*/
+#define HUFF_APP_REPLAY_LOG_ENTRIES   256        /* Runs remembered, a power of two */
+#define HUFF_APP_REPLAY_MAX_REPEATS   256        /* Maximum samples per replayed seed */
+
+/*
+** Interleaved A/B kernel comparison
+*/
+#define HUFF_APP_AB_MAX_PAIRS         500        /* Maximum ABBA quartets per comparison */
+
+/*
+** Adaptive stopping rule
+*/
+#define HUFF_APP_ADAPT_MIN_SAMPLES    10         /* Samples taken before the interval is trusted */
+#define HUFF_APP_ADAPT_MAX_SAMPLES    1024       /* Samples kept, a hard stop besides the time budget */
+#define HUFF_APP_ADAPT_DEFAULT_BUDGET 10000      /* Time budget when none is commanded, in ms */
+
+/*
+** Dispatch statistics
+*/
+#define HUFF_APP_DISPSTAT_MAX_CC      31         /* Highest command code with its own slot; higher ones share one */
+
+/*
+** Input-size sweep
+*/
+#define HUFF_APP_SWEEP_MIN_BYTES      1024       /* Default first size; sizes then double up to the maximum */
+
+/*
+** Decode service
+*/
+#define HUFF_APP_SERVICE_PIPE_DEPTH   16         /* Depth of the decode request pipe */
+#define HUFF_APP_SERVICE_BATCH_SIZE   8          /* Requests handled per wakeup of the service task */
+#define HUFF_APP_SERVICE_STACK_SIZE   8192       /* Stack size of the service task */
+#define HUFF_APP_SERVICE_PRIORITY     60         /* Above the benchmark runs, so requests are not starved */
+#define HUFF_APP_SERVICE_MAX_BOOKS    (1 + HUFF_APP_TBL_MAX_BOOKS) /* Book IDs: the current input, then the table */
+#define HUFF_APP_SERVICE_SWAP_TIMEOUT 100        /* Time allowed for decodes to leave a table bank, in ms */
+
+/*
+** Telemetry compression
+*/
+#define HUFF_APP_TLMC_PIPE_DEPTH      32         /* Packets queued between wakeups */
+#define HUFF_APP_TLMC_ADAPT_PACKETS   4          /* Packets between updates of an adaptive code book */
+#define HUFF_APP_TLMC_BOOK_REPEAT     32         /* Packets between repetitions of the current code book */
+
+/*
+** Code book cache
+*/
+#define HUFF_APP_BOOKCACHE_ENTRIES        8       /* Built code books and decode tables kept */
+#define HUFF_APP_BOOKCACHE_NEAR_MILLIBITS 250    /* Largest mean code length difference of a reused book */
+
+/*
+** Input corpus
+*/
+#define HUFF_APP_CORPUS_DEFAULT_FILE  "/cf/huff_corpus.bin" /* Corpus loaded at init, when present */
+#define HUFF_APP_CORPUS_CHUNK_SIZE    4096                  /* OSAL read size when the file is not mapped */
 
 #endif
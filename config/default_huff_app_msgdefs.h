@@ -36,9 +36,258 @@
 //     char   ValStr[HUFF_APP_STRING_VAL_LEN]; /**< An example string */
 // } HUFF_APP_DisplayParam_Payload_t;
 
+/**
+ * \brief Kind of background interference generated during a contended run
+ */
+enum HUFF_APP_InterfKind
+{
+    HUFF_APP_InterfKind_NONE   = 0, /**< No interference */
+    HUFF_APP_InterfKind_STREAM = 1, /**< Streaming read/write over a large buffer (memory bandwidth hog) */
+    HUFF_APP_InterfKind_CHASE  = 2, /**< Random pointer chasing over a large buffer (LLC thrasher) */
+    HUFF_APP_InterfKind_SPIN   = 3  /**< Register-only busy loop (CPU spinner) */
+};
+
+typedef uint8 HUFF_APP_InterfKind_Enum_t;
+
+typedef struct HUFF_APP_Contend_Payload
+{
+    HUFF_APP_InterfKind_Enum_t Kind;     /**< Kind of interference, see #HUFF_APP_InterfKind */
+    uint8                      NumTasks; /**< Number of interference child tasks */
+    uint16                     NumRuns;  /**< Benchmark runs per phase (uncontended, then contended) */
+} HUFF_APP_Contend_Payload_t;
+
+typedef struct HUFF_APP_Calibrate_Payload
+{
+    uint32 MinSampleMicros; /**< Minimum duration of one timed sample, 0 selects the platform default */
+} HUFF_APP_Calibrate_Payload_t;
+
+/**
+ * \brief Handling of samples taken while the CPU frequency was not stable
+ */
+enum HUFF_APP_GuardMode
+{
+    HUFF_APP_GuardMode_OFF    = 0, /**< No stability check */
+    HUFF_APP_GuardMode_FLAG   = 1, /**< Report unstable samples with a flag */
+    HUFF_APP_GuardMode_REJECT = 2  /**< Discard unstable samples and retry */
+};
+
+typedef uint8 HUFF_APP_GuardMode_Enum_t;
+
+typedef struct HUFF_APP_SetGuard_Payload
+{
+    HUFF_APP_GuardMode_Enum_t Mode;              /**< See #HUFF_APP_GuardMode */
+    uint8                     Normalize;         /**< Non-zero to report estimated cycles per iteration */
+    uint16                    TolerancePermille; /**< Allowed loop time drift across a sample, 0 selects the default */
+} HUFF_APP_SetGuard_Payload_t;
+
+/**
+ * \brief Source of the input decoded by scheduled benchmark runs
+ */
+enum HUFF_APP_InputMode
+{
+    HUFF_APP_InputMode_SEED   = 0, /**< bench_lib internal generator, driven by the randomizing seeds */
+    HUFF_APP_InputMode_CORPUS = 1, /**< Corpus file decoded by the in-app codec */
+    HUFF_APP_InputMode_GEN    = 2  /**< Synthetic input decoded by the in-app codec */
+};
+
+typedef uint8 HUFF_APP_InputMode_Enum_t;
+
+typedef struct HUFF_APP_LoadCorpus_Payload
+{
+    char FileName[HUFF_APP_FILENAME_LEN]; /**< Corpus file, empty to unload and return to seed mode */
+} HUFF_APP_LoadCorpus_Payload_t;
+
+/**
+ * \brief Symbol distribution of the synthetic input generator
+ *
+ * Real valued parameters are given in thousandths.
+ */
+enum HUFF_APP_GenDist
+{
+    HUFF_APP_GenDist_UNIFORM   = 0, /**< Uniform over the alphabet */
+    HUFF_APP_GenDist_ZIPF      = 1, /**< Zipf, P(k) ~ 1/(k+1)^s with s = Param1/1000 */
+    HUFF_APP_GenDist_GEOMETRIC = 2, /**< Geometric, P(k) ~ (1-p)^k with p = Param1/1000 */
+    HUFF_APP_GenDist_MIXTURE   = 3, /**< Param1 hot symbols drawn with probability Param2/1000, others uniform */
+    HUFF_APP_GenDist_RUNS      = 4  /**< Uniform symbols repeated in runs of mean length Param1 */
+};
+
+typedef uint8 HUFF_APP_GenDist_Enum_t;
+
+typedef struct HUFF_APP_Generate_Payload
+{
+    HUFF_APP_GenDist_Enum_t Distribution; /**< See #HUFF_APP_GenDist */
+    uint8                   Pipelined;    /**< Non-zero to decode a new input, with the next seed, on every run */
+    uint16                  AlphabetSize; /**< Number of distinct symbols, 1 to 256 */
+    uint32                  Length;       /**< Number of symbols to generate */
+    uint32                  Param1;       /**< First distribution parameter */
+    uint32                  Param2;       /**< Second distribution parameter */
+    uint32                  Seed;         /**< Generator seed */
+} HUFF_APP_Generate_Payload_t;
+
+typedef struct HUFF_APP_Sweep_Payload
+{
+    uint32 MinBytes; /**< First input size, 0 for the configured minimum */
+    uint32 MaxBytes; /**< Last input size, 0 for the whole current input */
+} HUFF_APP_Sweep_Payload_t;
+
+/**
+ * \brief Distribution of the blocks of a parallel decode across the workers
+ */
+enum HUFF_APP_ParDecSched
+{
+    HUFF_APP_ParDecSched_STATIC = 0, /**< One contiguous range of blocks per worker */
+    HUFF_APP_ParDecSched_STEAL  = 1  /**< Chunks of blocks in per-worker deques, idle workers steal */
+};
+
+typedef uint8 HUFF_APP_ParDecSched_Enum_t;
+
+typedef struct HUFF_APP_ParDecode_Payload
+{
+    uint8                       MaxWorkers; /**< Decodes with 1 up to MaxWorkers workers, 0 for all of them */
+    HUFF_APP_ParDecSched_Enum_t Sched;      /**< See #HUFF_APP_ParDecSched */
+    uint8                       spare[2];
+} HUFF_APP_ParDecode_Payload_t;
+
+/**
+ * \brief Output format of a trace dump
+ */
+enum HUFF_APP_TraceFormat
+{
+    HUFF_APP_TraceFormat_JSON   = 0, /**< Chrome trace-event JSON, for chrome://tracing or Perfetto */
+    HUFF_APP_TraceFormat_BINARY = 1  /**< Raw ring contents, converted offline by tools/huff_trace2json.py */
+};
+
+typedef uint8 HUFF_APP_TraceFormat_Enum_t;
+
+typedef struct HUFF_APP_TraceDump_Payload
+{
+    char                        FileName[HUFF_APP_FILENAME_LEN]; /**< Output file, empty for the default one */
+    HUFF_APP_TraceFormat_Enum_t Format;                          /**< See #HUFF_APP_TraceFormat */
+    uint8                       spare[3];
+} HUFF_APP_TraceDump_Payload_t;
+
+typedef struct HUFF_APP_PerfCapture_Payload
+{
+    char   FileName[HUFF_APP_FILENAME_LEN]; /**< Perf log file written by ES, empty for the ES default */
+    uint32 NumRuns;                         /**< Benchmark runs in the capture window */
+} HUFF_APP_PerfCapture_Payload_t;
+
+typedef struct HUFF_APP_Batch_Payload
+{
+    uint16 NumRuns; /**< Benchmark samples in the batch */
+    uint8  Record;  /**< Non-zero to store the batch as the baseline of this build instead of comparing */
+    uint8  spare;
+} HUFF_APP_Batch_Payload_t;
+
+typedef struct HUFF_APP_Replay_Payload
+{
+    uint16 Seed;    /**< Seed replayed when Count is zero */
+    uint16 Count;   /**< Non-zero to replay the Count most recently logged seeds instead, oldest first */
+    uint16 Repeats; /**< Samples per seed; zero sends the replay log as result sentences instead */
+    uint16 spare;
+} HUFF_APP_Replay_Payload_t;
+
+/**
+ * \brief Decode kernels compared by an A/B run
+ */
+enum HUFF_APP_AbKernel
+{
+    HUFF_APP_AbKernel_BENCH_LIB = 0, /**< BENCH_LIB_HuffBenchTask() on the seed chain */
+    HUFF_APP_AbKernel_TABLE     = 1, /**< In-app single lookup table decoder */
+    HUFF_APP_AbKernel_SERIAL    = 2, /**< In-app bit-serial canonical decoder */
+    HUFF_APP_AbKernel_PARALLEL  = 3  /**< In-app parallel block decoder, static schedule */
+};
+
+typedef uint8 HUFF_APP_AbKernel_Enum_t;
+
+typedef struct HUFF_APP_AbCompare_Payload
+{
+    HUFF_APP_AbKernel_Enum_t KernelA;   /**< See #HUFF_APP_AbKernel */
+    HUFF_APP_AbKernel_Enum_t KernelB;   /**< See #HUFF_APP_AbKernel */
+    uint8                    Workers;   /**< Workers of the parallel kernel, 0 for all of them */
+    uint8                    spare;
+    uint16                   NumPairs;  /**< ABBA quartets, each giving one paired difference */
+    uint16                   OrderSeed; /**< Seed of the ABBA / BAAB order draw, 0 to derive it from the time */
+} HUFF_APP_AbCompare_Payload_t;
+
+/**
+ * \brief Statistic whose confidence interval stops an adaptive run
+ */
+enum HUFF_APP_AdaptStat
+{
+    HUFF_APP_AdaptStat_MEAN   = 0, /**< Mean, Student t interval */
+    HUFF_APP_AdaptStat_MEDIAN = 1  /**< Median, distribution-free interval from order statistics */
+};
+
+typedef uint8 HUFF_APP_AdaptStat_Enum_t;
+
+typedef struct HUFF_APP_AdaptiveRun_Payload
+{
+    uint32                    TargetPpm;    /**< Target half-width of the 95% interval, in ppm of the estimate */
+    uint32                    BudgetMillis; /**< Time allowed to reach the target, 0 for the default */
+    HUFF_APP_AdaptStat_Enum_t Statistic;    /**< See #HUFF_APP_AdaptStat */
+    uint8                     spare[3];
+} HUFF_APP_AdaptiveRun_Payload_t;
+
+/**
+ * \brief Decode service request
+ *
+ * Only the first EncodedBytes of Data need to be sent, the message may be
+ * shortened accordingly.
+ */
+typedef struct HUFF_APP_DecodeReq_Payload
+{
+    uint32 CorrelationId; /**< Returned unchanged in the response */
+    uint16 ClientId;      /**< Requester identifier, for the per-client counters */
+    uint16 BookId;        /**< Code book the block was encoded with, 0 for the book of the current input */
+    uint32 NumSymbols;    /**< Number of symbols to decode */
+    uint32 EncodedBytes;  /**< Valid bytes in Data */
+    uint8  Data[HUFF_APP_DECODE_MAX_ENC_BYTES]; /**< MSB-first canonical Huffman code words */
+} HUFF_APP_DecodeReq_Payload_t;
+
+/**
+ * \brief Decode service response
+ *
+ * The message is sized to the NumSymbols decoded symbols.
+ */
+typedef struct HUFF_APP_DecodeRsp_Payload
+{
+    uint32 CorrelationId; /**< Copied from the request */
+    uint16 ClientId;      /**< Copied from the request */
+    uint16 BookId;        /**< Copied from the request */
+    int32  Status;        /**< CFE_SUCCESS, or the reason why the block was not decoded */
+    uint32 NumSymbols;    /**< Valid symbols in Data */
+    uint8  Data[HUFF_APP_DECODE_MAX_SYMBOLS]; /**< Decoded symbols */
+} HUFF_APP_DecodeRsp_Payload_t;
+
+/**
+ * \name Flags of a compressed telemetry packet
+ * \{
+ */
+#define HUFF_APP_TLMC_FLAG_STORED 0x01 /**< Data holds the payload unchanged */
+#define HUFF_APP_TLMC_FLAG_BOOK   0x02 /**< Data starts with the code lengths of the book, two per byte */
+/**\}*/
+
+/**
+ * \brief Compressed telemetry packet payload
+ *
+ * When HUFF_APP_TLMC_FLAG_BOOK is set, the first HUFF_APP_CODEC_SYMBOLS / 2
+ * bytes of Data hold the code lengths of book BookGeneration, high nibble
+ * first; the canonical codes follow from the lengths.
+ */
+typedef struct HUFF_APP_TlmcTlm_Payload
+{
+    uint8  Flags;          /**< HUFF_APP_TLMC_FLAG_* */
+    uint8  spare;
+    uint16 BookGeneration; /**< Code book the payload was encoded with */
+    uint16 PayloadBytes;   /**< Size of the original payload */
+    uint16 DataBytes;      /**< Valid bytes in Data */
+    uint8  Data[HUFF_APP_CODEC_SYMBOLS / 2 + HUFF_APP_TLMC_MAX_PAYLOAD];
+} HUFF_APP_TlmcTlm_Payload_t;
+
 typedef struct HUFF_APP_ResultTlm_Payload
 {
-    char   ResultStr[HUFF_APP_STRING_VAL_LEN]; /**< Formatted result text string */
+    char   ResultStr[HUFF_APP_RESULT_STR_LEN]; /**< Formatted result text string */
 } HUFF_APP_ResultTlm_Payload_t;
 
 
@@ -47,11 +296,117 @@ typedef struct HUFF_APP_ResultTlm_Payload
 ** Type definition (Sample App housekeeping)
 */
 
+/**
+ * \brief Decode service counters of one client
+ */
+typedef struct HUFF_APP_DecodeClientTlm
+{
+    uint16 ClientId;
+    uint16 spare;
+    uint32 Requests;     /**< Requests received */
+    uint32 Errors;       /**< Requests answered with an error status */
+    uint32 EncodedBytes; /**< Encoded bytes decoded */
+    uint32 Symbols;      /**< Symbols returned */
+    uint32 DecodeMicros; /**< Time spent decoding, for the client throughput */
+} HUFF_APP_DecodeClientTlm_t;
+
+/**
+ * \brief Telemetry compression counters of one MID
+ */
+typedef struct HUFF_APP_TlmcMidTlm
+{
+    uint32 MsgId;
+    uint32 Packets;         /**< Packets republished */
+    uint32 StoredPackets;   /**< Packets republished uncompressed */
+    uint32 PayloadBytes;    /**< Original payload bytes */
+    uint32 DataBytes;       /**< Bytes sent in place of the payloads, code books included */
+    uint32 EncodeMicros;    /**< Total encode latency */
+    uint16 RatioPermille;   /**< DataBytes / PayloadBytes */
+    uint16 MaxEncodeMicros; /**< Worst encode latency of a packet */
+} HUFF_APP_TlmcMidTlm_t;
+
+/**
+ * \brief Parallel decode counters of one worker
+ */
+typedef struct HUFF_APP_ParDecWorkerTlm
+{
+    uint32 Chunks;         /**< Chunks decoded, stolen ones included */
+    uint32 Steals;         /**< Chunks taken from the deque of another worker */
+    uint32 BusyMicros;     /**< Time spent decoding */
+    uint16 UtilPermille;   /**< BusyMicros / elapsed time of the jobs the worker took part in */
+    uint16 spare;
+} HUFF_APP_ParDecWorkerTlm_t;
+
+/**
+ * \brief Kinds of work the app is busy with, for its duty cycle accounting
+ */
+enum HUFF_APP_DutyMsg
+{
+    HUFF_APP_DutyMsg_GROUND_CMD  = 0, /**< Ground commands on the main task, benchmark ones only queued */
+    HUFF_APP_DutyMsg_WORK        = 1, /**< Scheduled run requests, only queued */
+    HUFF_APP_DutyMsg_SEND_HK     = 2, /**< Housekeeping requests */
+    HUFF_APP_DutyMsg_TLMC_WAKEUP = 3, /**< Telemetry compression wakeups */
+    HUFF_APP_DutyMsg_OTHER       = 4, /**< Unknown message IDs */
+    HUFF_APP_DutyMsg_JOB         = 5  /**< Benchmark commands and runs, on the executor task */
+};
+
+#define HUFF_APP_DUTY_MSG_TYPES 6
+
+/**
+ * \brief Busy time of one kind of work
+ */
+typedef struct HUFF_APP_DutyMsgTlm
+{
+    uint32 Count;      /**< Messages (or executor jobs) handled */
+    uint32 BusyMicros; /**< Total handling time, wraps: use differences between HK packets */
+    uint32 MaxMicros;  /**< Longest single handling time */
+} HUFF_APP_DutyMsgTlm_t;
+
 typedef struct HUFF_APP_HkTlm_Payload
 {
     uint8 CommandErrorCounter;
     uint8 CommandCounter;
-    uint8 spare[2];
+    uint8 InputMode; /**< See #HUFF_APP_InputMode */
+    uint8 spare;
+    uint32 IterationCount;  /**< Benchmark invocations per timed sample */
+    uint32 MinSampleMicros; /**< Minimum sample duration the iteration count was calibrated for */
+    uint32 FlaggedSampleCount;  /**< Samples reported with an unstable CPU frequency */
+    uint32 RejectedSampleCount; /**< Samples discarded because of an unstable CPU frequency */
+    uint32 DecodeUntrackedRequests; /**< Decode requests from clients beyond the tracked ones */
+    HUFF_APP_DecodeClientTlm_t DecodeClient[HUFF_APP_DECODE_MAX_CLIENTS]; /**< Decode service counters */
+    uint32 TlmcBudgetOverruns; /**< Wakeups that ran out of compression time */
+    uint32 TlmcDroppedPackets; /**< Subscribed packets too large or too short to compress */
+    HUFF_APP_TlmcMidTlm_t TlmcMid[HUFF_APP_TLMC_MAX_MIDS]; /**< Telemetry compression counters */
+    uint32 BookCacheLookups;         /**< Code books requested from the cache */
+    uint32 BookCacheHits;            /**< Requests served by a book built for the same statistics */
+    uint32 BookCacheNearHits;        /**< Requests served by a book built for similar statistics */
+    uint32 BookCacheSavedMicros;     /**< Estimated build time saved by the cache */
+    uint16 BookCacheHitRatePermille; /**< (Hits + NearHits) / Lookups */
+    uint16 spare2;
+    uint32 ParDecJobs;               /**< Parallel decodes of a whole input */
+    uint32 ParDecSteals;             /**< Chunks stolen, all workers */
+    HUFF_APP_ParDecWorkerTlm_t ParDecWorker[HUFF_APP_PARDEC_MAX_WORKERS]; /**< Parallel decode counters */
+    uint8  ExecQueueDepth;           /**< Benchmark commands waiting for the executor */
+    uint8  ExecRunning;              /**< Non-zero while the executor runs a benchmark command */
+    uint16 spare3;
+    uint32 ExecJobsDone;             /**< Benchmark commands run to completion */
+    uint32 ExecJobsCancelled;        /**< Benchmark commands cancelled, queued or running */
+    uint32 ExecJobsRejected;         /**< Benchmark commands dropped because the queue was full */
+    uint32 DutyIntervalMicros;       /**< Time since the previous HK packet */
+    uint16 DutyPermille;             /**< Busy share of the interval, main task */
+    uint16 ExecDutyPermille;         /**< Busy share of the interval, executor task */
+    HUFF_APP_DutyMsgTlm_t DutyMsg[HUFF_APP_DUTY_MSG_TYPES]; /**< Busy time per kind of work */
+    uint32 CommandCount;             /**< Commands accepted, CommandCounter without the wrap at 255 */
+    uint32 CommandErrorCount;        /**< Commands rejected, CommandErrorCounter without the wrap at 255 */
+    uint32 RunCount;                 /**< Benchmark runs, WORK messages and perf captures */
+    uint32 RunSuccessCount;          /**< Runs that decoded and verified without error */
+    uint32 RunFailureCount;          /**< Runs that returned an error */
+    uint32 DroppedMsgCount;          /**< Messages discarded: unknown MID or CC, bad length, executor queue full */
+    uint32 DecodeKiloBytesPerSec;    /**< Output bytes decoded since the previous HK packet, MB/s x 1000 */
+    uint32 DecodeSymbolsPerSec;      /**< Symbols decoded since the previous HK packet */
+    uint32 spare4;
+    uint64 DecodedBytes;             /**< Output bytes decoded by every benchmark command, as in result kB/s */
+    uint64 DecodedSymbols;           /**< Symbols decoded by every benchmark command */
 } HUFF_APP_HkTlm_Payload_t;
 
 #endif
@@ -26,11 +26,15 @@
 #include "cfe_core_api_base_msgids.h"
 #include "huff_app_topicids.h"
 
-#define HUFF_APP_CMD_MID       CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_CMD_TOPICID)
-#define HUFF_APP_SEND_HK_MID   CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_SEND_HK_TOPICID)
-#define HUFF_APP_CMD_WORK_MID  CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_WORK_TOPICID)
+#define HUFF_APP_CMD_MID         CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_CMD_TOPICID)
+#define HUFF_APP_SEND_HK_MID     CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_SEND_HK_TOPICID)
+#define HUFF_APP_CMD_WORK_MID    CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_WORK_TOPICID)
+#define HUFF_APP_DECODE_REQ_MID  CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_DECODE_REQ_TOPICID)
+#define HUFF_APP_TLMC_WAKEUP_MID CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_TLMC_WAKEUP_TOPICID)
 
-#define HUFF_APP_HK_TLM_MID  CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_HK_TLM_TOPICID)
-#define HUFF_APP_RES_TLM_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_RES_TLM_TOPICID)
+#define HUFF_APP_HK_TLM_MID      CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_HK_TLM_TOPICID)
+#define HUFF_APP_RES_TLM_MID     CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_RES_TLM_TOPICID)
+#define HUFF_APP_DECODE_RSP_MID  CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_DECODE_RSP_TOPICID)
+#define HUFF_APP_TLMC_TLM_MID    CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_HUFF_APP_TLMC_TLM_TOPICID)
 
 #endif
@@ -55,11 +55,99 @@ typedef struct
     CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
 } HUFF_APP_ResetCountersCmd_t;
 
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} HUFF_APP_CancelCmd_t;
+
 typedef struct
 {
     CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
 } HUFF_APP_RunCmd_t;
 
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} HUFF_APP_DispatchStatsCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t    CommandHeader; /**< \brief Command header */
+    HUFF_APP_Contend_Payload_t Payload;
+} HUFF_APP_ContendCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CommandHeader; /**< \brief Command header */
+    HUFF_APP_Calibrate_Payload_t Payload;
+} HUFF_APP_CalibrateCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CommandHeader; /**< \brief Command header */
+    HUFF_APP_SetGuard_Payload_t Payload;
+} HUFF_APP_SetGuardCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t       CommandHeader; /**< \brief Command header */
+    HUFF_APP_LoadCorpus_Payload_t Payload;
+} HUFF_APP_LoadCorpusCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CommandHeader; /**< \brief Command header */
+    HUFF_APP_Generate_Payload_t Payload;
+} HUFF_APP_GenerateCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t  CommandHeader; /**< \brief Command header */
+    HUFF_APP_Sweep_Payload_t Payload;
+} HUFF_APP_SweepCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CommandHeader; /**< \brief Command header */
+    HUFF_APP_ParDecode_Payload_t Payload;
+} HUFF_APP_ParDecodeCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CommandHeader; /**< \brief Command header */
+    HUFF_APP_TraceDump_Payload_t Payload;
+} HUFF_APP_TraceDumpCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t        CommandHeader; /**< \brief Command header */
+    HUFF_APP_PerfCapture_Payload_t Payload;
+} HUFF_APP_PerfCaptureCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t  CommandHeader; /**< \brief Command header */
+    HUFF_APP_Batch_Payload_t Payload;
+} HUFF_APP_BatchCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t   CommandHeader; /**< \brief Command header */
+    HUFF_APP_Replay_Payload_t Payload;
+} HUFF_APP_ReplayCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CommandHeader; /**< \brief Command header */
+    HUFF_APP_AbCompare_Payload_t Payload;
+} HUFF_APP_AbCompareCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t        CommandHeader; /**< \brief Command header */
+    HUFF_APP_AdaptiveRun_Payload_t Payload;
+} HUFF_APP_AdaptiveRunCmd_t;
+
 // typedef struct
 // {
 //     CFE_MSG_CommandHeader_t           CommandHeader; /**< \brief Command header */
@@ -90,5 +178,39 @@ typedef struct
     HUFF_APP_ResultTlm_Payload_t   Payload;         /**< \brief Processing result payload */
 } HUFF_APP_ResultTlm_t;
 
+/*************************************************************************/
+/*
+** Type definition (HUFF App telemetry compression)
+*/
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} HUFF_APP_TlmcWakeupCmd_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t  TelemetryHeader; /**< \brief Telemetry header */
+    CFE_MSG_TelemetryHeader_t  OriginalHeader;  /**< \brief Header of the compressed packet, unchanged */
+    HUFF_APP_TlmcTlm_Payload_t Payload;
+} HUFF_APP_TlmcTlm_t;
+
+/*************************************************************************/
+/*
+** Type definition (HUFF App decode service)
+*/
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CommandHeader; /**< \brief Command header */
+    HUFF_APP_DecodeReq_Payload_t Payload;
+} HUFF_APP_DecodeReqCmd_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t    TelemetryHeader; /**< \brief Telemetry header */
+    HUFF_APP_DecodeRsp_Payload_t Payload;
+} HUFF_APP_DecodeRspTlm_t;
+
 
 #endif /* HUFF_APP_MSGSTRUCT_H */
@@ -23,6 +23,9 @@
 #ifndef HUFF_APP_PERFIDS_H
 #define HUFF_APP_PERFIDS_H
 
-#define HUFF_APP_PERF_ID 91
+#define HUFF_APP_PERF_ID         91
+#define HUFF_APP_SERVICE_PERF_ID 92
+#define HUFF_APP_EXEC_PERF_ID    93 /* One benchmark command on the executor */
+#define HUFF_APP_RUN_PERF_ID     94 /* One run of a perf capture, also its trigger */
 
 #endif
@@ -31,6 +31,11 @@
 #include "huff_app_tblstruct.h"
 
 /* Define filenames of default data images for tables */
-//#define HUFF_APP_TABLE_FILE "/cf/HUFF_APP_tbl.tbl"
+#define HUFF_APP_TABLE_FILE      "/cf/huff_app_tbl.tbl"
+#define HUFF_APP_TLMC_TABLE_FILE "/cf/huff_app_tlmc_tbl.tbl"
+
+/* Recorded baselines are dumped back over their own image, so they survive a restart */
+#define HUFF_APP_BASELINE_TABLE_FILE "/cf/huff_app_baseline_tbl.tbl"
+#define HUFF_APP_BASELINE_TABLE_NAME "HUFF_APP.BaselineTable"
 
 #endif
@@ -34,12 +34,62 @@
 #include "huff_app_mission_cfg.h"
 
 /*
-** Example Table structure
+** Code book table
 */
 typedef struct
 {
-    uint16 Int1;
-    uint16 Int2;
-} HUFF_APP_ExampleTable_t;
+    uint8 Lengths[HUFF_APP_CODEC_SYMBOLS]; /**< Canonical code lengths, all 0 for an unused book */
+} HUFF_APP_BookTableEntry_t;
+
+typedef struct
+{
+    HUFF_APP_BookTableEntry_t Book[HUFF_APP_TBL_MAX_BOOKS];
+} HUFF_APP_BookTable_t;
+
+/*
+** Telemetry compression table
+*/
+enum HUFF_APP_TlmcBook
+{
+    HUFF_APP_TlmcBook_ADAPTIVE = 0, /**< Rebuilt from the packets seen so far */
+    HUFF_APP_TlmcBook_STATIC   = 1  /**< Code lengths given in the table */
+};
+
+typedef uint8 HUFF_APP_TlmcBook_Enum_t;
+
+typedef struct
+{
+    uint32                   MsgId;    /**< Telemetry MID to compress, 0 for an unused entry */
+    HUFF_APP_TlmcBook_Enum_t BookMode; /**< See #HUFF_APP_TlmcBook */
+    uint8                    spare[3];
+    uint8                    Lengths[HUFF_APP_CODEC_SYMBOLS]; /**< Code lengths of a static book */
+} HUFF_APP_TlmcEntry_t;
+
+typedef struct
+{
+    uint32               CpuBudgetMicros; /**< Compression time allowed per wakeup */
+    HUFF_APP_TlmcEntry_t Entry[HUFF_APP_TLMC_MAX_MIDS];
+} HUFF_APP_TlmcTable_t;
+
+/*
+** Performance baseline table
+*/
+typedef struct
+{
+    uint8  Valid;         /**< Non-zero for a used entry */
+    uint8  BuildFlags;    /**< BENCH_LIB_u8BuildFlags() of the measured build */
+    uint8  CacheSettings; /**< BENCH_LIB_u8GetCacheSettings() of the measured build */
+    uint8  spare;
+    uint32 Samples;       /**< Number of samples the baseline was computed from */
+    uint32 MedianNanos;   /**< Median time per benchmark invocation */
+    uint32 MadNanos;      /**< Median absolute deviation of the time per invocation */
+} HUFF_APP_BaselineEntry_t;
+
+typedef struct
+{
+    uint32                   ZThresholdMilli;  /**< Robust z score, in thousandths, of a significant change */
+    uint32                   MinDeltaPermille; /**< Smallest change of the median reported */
+    HUFF_APP_BaselineEntry_t Entry[HUFF_APP_BASELINE_MAX_ENTRIES];
+} HUFF_APP_BaselineTable_t;
 
 #endif
@@ -23,11 +23,15 @@
 #ifndef HUFF_APP_TOPICIDS_H
 #define HUFF_APP_TOPICIDS_H
 
-#define CFE_MISSION_HUFF_APP_CMD_TOPICID       0x97
-#define CFE_MISSION_HUFF_APP_WORK_TOPICID      0x98
-#define CFE_MISSION_HUFF_APP_SEND_HK_TOPICID   0x99
+#define CFE_MISSION_HUFF_APP_CMD_TOPICID         0x97
+#define CFE_MISSION_HUFF_APP_WORK_TOPICID        0x98
+#define CFE_MISSION_HUFF_APP_SEND_HK_TOPICID     0x99
+#define CFE_MISSION_HUFF_APP_DECODE_REQ_TOPICID  0x9A
+#define CFE_MISSION_HUFF_APP_TLMC_WAKEUP_TOPICID 0x9B
 
-#define CFE_MISSION_HUFF_APP_RES_TLM_TOPICID   0x98
-#define CFE_MISSION_HUFF_APP_HK_TLM_TOPICID    0x99
+#define CFE_MISSION_HUFF_APP_RES_TLM_TOPICID     0x98
+#define CFE_MISSION_HUFF_APP_HK_TLM_TOPICID      0x99
+#define CFE_MISSION_HUFF_APP_DECODE_RSP_TOPICID  0x9A
+#define CFE_MISSION_HUFF_APP_TLMC_TLM_TOPICID    0x9B
 
 #endif
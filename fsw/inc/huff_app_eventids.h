@@ -34,5 +34,37 @@
 #define HUFF_APP_CMD_LEN_ERR_EID 6
 #define HUFF_APP_PIPE_ERR_EID    7
 #define HUFF_APP_VALUE_INF_EID   8
+#define HUFF_APP_CONTEND_INF_EID 9
+#define HUFF_APP_CONTEND_ERR_EID 10
+#define HUFF_APP_CALIB_INF_EID   11
+#define HUFF_APP_GUARD_INF_EID   12
+#define HUFF_APP_GUARD_ERR_EID   13
+#define HUFF_APP_CORPUS_INF_EID  14
+#define HUFF_APP_CORPUS_ERR_EID  15
+#define HUFF_APP_GEN_INF_EID     16
+#define HUFF_APP_GEN_ERR_EID     17
+#define HUFF_APP_SWEEP_INF_EID   18
+#define HUFF_APP_SWEEP_ERR_EID   19
+#define HUFF_APP_SERVICE_ERR_EID 20
+#define HUFF_APP_TLMC_INF_EID    21
+#define HUFF_APP_TLMC_ERR_EID    22
+#define HUFF_APP_PARDEC_INF_EID  23
+#define HUFF_APP_PARDEC_ERR_EID  24
+#define HUFF_APP_EXEC_INF_EID    25
+#define HUFF_APP_EXEC_ERR_EID    26
+#define HUFF_APP_TRACE_INF_EID   27
+#define HUFF_APP_TRACE_ERR_EID   28
+#define HUFF_APP_PERFCAP_INF_EID 29
+#define HUFF_APP_PERFCAP_ERR_EID 30
+#define HUFF_APP_BASE_INF_EID    31
+#define HUFF_APP_BASE_ERR_EID    32
+#define HUFF_APP_REGRESS_ERR_EID 33
+#define HUFF_APP_REPLAY_INF_EID  34
+#define HUFF_APP_REPLAY_ERR_EID  35
+#define HUFF_APP_AB_INF_EID      36
+#define HUFF_APP_AB_ERR_EID      37
+#define HUFF_APP_ADAPT_INF_EID   38
+#define HUFF_APP_ADAPT_ERR_EID   39
+#define HUFF_APP_DISP_INF_EID    40
 
 #endif /* HUFF_APP_EVENTS_H */
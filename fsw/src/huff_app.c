@@ -29,15 +29,23 @@
 #include "huff_app_utils.h"
 #include "huff_app_eventids.h"
 #include "huff_app_dispatch.h"
+#include "huff_app_dispstat.h"
+#include "huff_app_duty.h"
 #include "huff_app_tbl.h"
 #include "huff_app_version.h"
+#include "huff_app_baseline.h"
+#include "huff_app_corpus.h"
+#include "huff_app_exec.h"
+#include "huff_app_service.h"
+#include "huff_app_tlmc.h"
+#include "huff_app_trace.h"
 
 /*
 ** global data
 */
 HUFF_APP_Data_t HUFF_APP_Data;
 
-extern HUFF_APP_ExampleTable_t ExampleTable;
+extern HUFF_APP_BookTable_t HUFF_APP_BookDefaultTable;
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * *  * * * * **/
 /*                                                                            */
@@ -48,12 +56,15 @@ void HUFF_APP_Main(void)
 {
     int32            status;
     CFE_SB_Buffer_t *SBBufPtr;
+    uint64           BusyTicks;
 
     /*
     ** Create the first Performance Log entry
     */
     CFE_ES_PerfLogEntry(HUFF_APP_PERF_ID);
 
+    HUFF_APP_TraceAttach("HUFF_APP");
+
     /*
     ** Perform application-specific initialization
     ** If the Initialization fails, set the RunStatus to
@@ -76,7 +87,10 @@ void HUFF_APP_Main(void)
         CFE_ES_PerfLogExit(HUFF_APP_PERF_ID);
 
         /* Pend on receipt of command packet */
+        HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_RECEIVE);
         status = CFE_SB_ReceiveBuffer(&SBBufPtr, HUFF_APP_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+        HUFF_APP_TRACE_END(HUFF_APP_TRACE_RECEIVE);
+        BusyTicks = HUFF_APP_DutyNow();
 
         /*
         ** Performance Log Entry Stamp
@@ -85,7 +99,11 @@ void HUFF_APP_Main(void)
 
         if (status == CFE_SUCCESS)
         {
+            HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DISPATCH);
             HUFF_APP_TaskPipe(SBBufPtr);
+            HUFF_APP_TRACE_END(HUFF_APP_TRACE_DISPATCH);
+            HUFF_APP_DutyMsgDone(SBBufPtr, BusyTicks);
+            HUFF_APP_DispStatMsgDone(SBBufPtr, BusyTicks);
         }
         else
         {
@@ -115,17 +133,24 @@ int32 HUFF_APP_Init(void)
     char VersionString[HUFF_APP_CFG_MAX_VERSION_STR_LEN];
     osal_id_t     TimeBaseId = OS_OBJECT_ID_UNDEFINED;
     int32         OsStatus;
+    os_fstat_t    CorpusStat; /* Also used for the table file */
 
     /* Zero out the global data structure */
     memset(&HUFF_APP_Data, 0, sizeof(HUFF_APP_Data));
 
     HUFF_APP_Data.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
+    /* Busy time is accounted from here, initialization included */
+    HUFF_APP_DutyInit();
+
     /*
     ** Initialize app configuration data
     */
     HUFF_APP_Data.PipeDepth = HUFF_APP_PIPE_DEPTH;
 
+    HUFF_APP_Data.GuardMode              = HUFF_APP_GuardMode_FLAG;
+    HUFF_APP_Data.GuardTolerancePermille = HUFF_APP_GUARD_DEFAULT_TOLERANCE;
+
     strncpy(HUFF_APP_Data.PipeName, "HUFF_APP_CMD_PIPE", sizeof(HUFF_APP_Data.PipeName));
     HUFF_APP_Data.PipeName[sizeof(HUFF_APP_Data.PipeName) - 1] = 0;
 
@@ -220,20 +245,107 @@ int32 HUFF_APP_Init(void)
 
     if (status == CFE_SUCCESS)
     {
-        // /*
-        // ** Register Example Table(s)
-        // */
-        // status = CFE_TBL_Register(&HUFF_APP_Data.TblHandles[0], "ExampleTable", sizeof(HUFF_APP_ExampleTable_t),
-        //                           CFE_TBL_OPT_DEFAULT, HUFF_APP_TblValidationFunc);
-        // if (status != CFE_SUCCESS)
-        // {
-        //     CFE_ES_WriteToSysLog("Sample App: Error Registering Example Table, RC = 0x%08lX\n", (unsigned long)status);
-        // }
-        // else
-        // {
-        //     //status = CFE_TBL_Load(HUFF_APP_Data.TblHandles[0], CFE_TBL_SRC_FILE, HUFF_APP_TABLE_FILE);
-        //     status = CFE_TBL_Load(HUFF_APP_Data.TblHandles[0], CFE_TBL_SRC_ADDRESS, &ExampleTable);
-        // }
+        /*
+        ** Subscribe to telemetry compression wakeups
+        */
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(HUFF_APP_TLMC_WAKEUP_MID), HUFF_APP_Data.CommandPipe);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error Subscribing to Wakeup, RC = 0x%08lX\n", (unsigned long)status);
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Set up telemetry compression from its table
+        */
+        status = HUFF_APP_TlmcInit();
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error setting up telemetry compression, RC = 0x%08lX\n",
+                                 (unsigned long)status);
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Register the performance baseline table
+        */
+        status = HUFF_APP_BaselineInit();
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error registering baseline table, RC = 0x%08lX\n",
+                                 (unsigned long)status);
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Start the decode service for other apps
+        */
+        status = HUFF_APP_ServiceInit();
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error starting decode service, RC = 0x%08lX\n", (unsigned long)status);
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Start the executor of the benchmark commands. It opens the performance
+        ** counters and calibrates the iteration count before its first command.
+        */
+        status = HUFF_APP_ExecInit();
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error starting benchmark executor, RC = 0x%08lX\n",
+                                 (unsigned long)status);
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Register Code Book Table(s)
+        */
+        status = CFE_TBL_Register(&HUFF_APP_Data.TblHandles[0], "BookTable", sizeof(HUFF_APP_BookTable_t),
+                                  CFE_TBL_OPT_DEFAULT, HUFF_APP_TblValidationFunc);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error Registering Code Book Table, RC = 0x%08lX\n", (unsigned long)status);
+            return status;
+        }
+
+        /* The mission table file when there is one, the built-in books otherwise */
+        if (OS_stat(HUFF_APP_TABLE_FILE, &CorpusStat) == OS_SUCCESS)
+        {
+            status = CFE_TBL_Load(HUFF_APP_Data.TblHandles[0], CFE_TBL_SRC_FILE, HUFF_APP_TABLE_FILE);
+        }
+        else
+        {
+            status = CFE_TBL_Load(HUFF_APP_Data.TblHandles[0], CFE_TBL_SRC_ADDRESS, &HUFF_APP_BookDefaultTable);
+        }
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Sample App: Error Loading Code Book Table, RC = 0x%08lX\n", (unsigned long)status);
+            return status;
+        }
+
+        /* Build the decode tables now, not on the first decode */
+        HUFF_APP_Data.TblBooksPending = HUFF_APP_TBL_ALL_BOOKS;
+        HUFF_APP_TblApplyBooks();
+
+        /*
+        ** Decode the default corpus instead of seeded inputs, when there is one
+        */
+        if (OS_stat(HUFF_APP_CORPUS_DEFAULT_FILE, &CorpusStat) == OS_SUCCESS)
+        {
+            HUFF_APP_CorpusLoad(HUFF_APP_CORPUS_DEFAULT_FILE);
+        }
 
         CFE_Config_GetVersionString(VersionString, HUFF_APP_CFG_MAX_VERSION_STR_LEN, "HUFF App",
                           HUFF_APP_VERSION, HUFF_APP_BUILD_CODENAME, HUFF_APP_LAST_OFFICIAL);
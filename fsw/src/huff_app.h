@@ -28,6 +28,8 @@
 /*
 ** Required header files.
 */
+#include <stdatomic.h>
+
 #include "cfe.h"
 #include "cfe_config.h"
 
@@ -48,10 +50,12 @@
 typedef struct
 {
     /*
-    ** Command interface counters...
+    ** Command interface counters. The command ones are incremented by the
+    ** handlers of both the main and the executor task.
     */
-    uint8 CmdCounter;
-    uint8 ErrCounter;
+    atomic_uint CmdCounter;
+    atomic_uint ErrCounter;
+    uint32      DroppedMsgCount;
 
     /*
     ** Housekeeping telemetry packet...
@@ -80,12 +84,37 @@ typedef struct
     char   PipeName[CFE_MISSION_MAX_API_LEN];
     uint16 PipeDepth;
 
-    //CFE_TBL_Handle_t TblHandles[HUFF_APP_NUMBER_OF_TABLES];
+    CFE_TBL_Handle_t TblHandles[HUFF_APP_NUMBER_OF_TABLES];
+    uint32           TblBooksPending; /* Books whose decode tables are still to be rebuilt */
 
     uint16_t RandomizingSeed_1;
     uint16_t RandomizingSeed_2;
     uint16_t RandomizingSeed_3;
 
+    HUFF_APP_InputMode_Enum_t InputMode;
+
+    /*
+    ** Benchmark invocations per timed sample, chosen by calibration
+    */
+    uint32 IterationCount;
+    uint32 MinSampleMicros;
+
+    /*
+    ** CPU frequency stability guard
+    */
+    HUFF_APP_GuardMode_Enum_t GuardMode;
+    bool                      GuardNormalize;
+    uint16                    GuardTolerancePermille;
+    uint32                    FlaggedSampleCount;
+    uint32                    RejectedSampleCount;
+
+    /*
+    ** Decode totals at the previous HK packet, for the interval throughput
+    */
+    int64  HkLastMicros;
+    uint64 HkLastDecodedBytes;
+    uint64 HkLastDecodedSymbols;
+
     osal_id_t        TimeBaseId;
 } HUFF_APP_Data_t;
 
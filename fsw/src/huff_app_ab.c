@@ -0,0 +1,357 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App A/B kernel comparison.
+ *
+ *   Two decode kernels are timed alternately on the same input, in quartets
+ *   drawn at random as ABBA or BAAB. Within a quartet both kernels see the
+ *   same linear drift (thermal, frequency, background load), which cancels
+ *   in the paired difference ((A1 + A2) - (B1 + B2)) / 2; the random order
+ *   keeps periodic disturbances from lining up with either kernel. The mean
+ *   difference is reported with its 95% confidence interval.
+ *
+ *   The in-app kernels all decode the current workload, and each output is
+ *   checked against the original input. bench_lib generates its own input
+ *   from a seed, so it is only compared with itself (an A/A run measuring
+ *   the noise floor), each quartet on one seed of the chain with the check
+ *   values of both sides compared.
+ */
+
+/*
+** Include Files:
+*/
+#include <math.h>
+
+#include "huff_app.h"
+#include "huff_app_ab.h"
+#include "huff_app_bench.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_pardec.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+/*
+** One timed run of a kernel
+*/
+typedef struct
+{
+    int32  Status;         /* Kernel or verification failure, CFE_SUCCESS otherwise */
+    uint16 Check;          /* Decoder check value of a bench_lib run, 0 otherwise */
+    int64  DurationMicros; /* Elapsed time of the run */
+} HUFF_APP_AbSample_t;
+
+/*
+** Kernels being compared and what they run on
+*/
+typedef struct
+{
+    const HUFF_APP_Workload_t *Workload; /* NULL for bench_lib */
+    uint8                      Workers;  /* Decoders of the parallel kernel */
+} HUFF_APP_AbSetup_t;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Next bit of the ABBA / BAAB order draw (16-bit xorshift)        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HUFF_APP_AbOrderBit(uint16 *State)
+{
+    uint16 x = *State;
+
+    x ^= (uint16)(x << 7);
+    x ^= (uint16)(x >> 9);
+    x ^= (uint16)(x << 8);
+    *State = x;
+
+    return (x & 0x8000) != 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Time Iterations back-to-back invocations of a kernel            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HUFF_APP_AbSample(const HUFF_APP_AbSetup_t *Setup, HUFF_APP_AbKernel_Enum_t Kernel, uint16 Seed,
+                              uint32 Iterations, HUFF_APP_AbSample_t *Sample)
+{
+    const HUFF_APP_Workload_t *Workload = Setup->Workload;
+    HUFF_APP_Sample_t          BenchSample;
+    HUFF_APP_DecodeResult_t    Result;
+
+    Sample->Check = 0;
+
+    if (Kernel == HUFF_APP_AbKernel_BENCH_LIB)
+    {
+        HUFF_APP_BenchSample(Seed, Iterations, &BenchSample);
+        Sample->Status         = BenchSample.Status;
+        Sample->Check          = BenchSample.CheckD;
+        Sample->DurationMicros = BenchSample.DurationMicros;
+        return;
+    }
+
+    /* Cleared outside the timed region, so a kernel cannot pass on the output of the other one */
+    memset(HUFF_APP_WorkloadOutBuf, 0, Workload->Length);
+    Result.Iterations = Iterations;
+
+    switch (Kernel)
+    {
+        case HUFF_APP_AbKernel_TABLE:
+            HUFF_APP_WorkloadDecode(Workload, Workload->Length, HUFF_APP_WorkloadOutBuf, &Result);
+            break;
+
+        case HUFF_APP_AbKernel_SERIAL:
+            HUFF_APP_WorkloadDecodeSerial(Workload, Workload->Length, HUFF_APP_WorkloadOutBuf, &Result);
+            break;
+
+        default:
+            HUFF_APP_ParDecDecode(Workload, Setup->Workers, HUFF_APP_ParDecSched_STATIC, HUFF_APP_WorkloadOutBuf,
+                                  &Result);
+            break;
+    }
+
+    Sample->Status         = Result.Status;
+    Sample->DurationMicros = Result.DurationMicros;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Iterations per run of a kernel, doubled until a run lasts at    */
+/* least the calibrated minimum sample time. Also warms it up.     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 HUFF_APP_AbCalibrate(const HUFF_APP_AbSetup_t *Setup, HUFF_APP_AbKernel_Enum_t Kernel, uint16 Seed)
+{
+    HUFF_APP_AbSample_t Sample;
+    uint32              Iterations = 1;
+
+    while (true)
+    {
+        HUFF_APP_AbSample(Setup, Kernel, Seed, Iterations, &Sample);
+        if (Sample.Status != CFE_SUCCESS || Sample.DurationMicros >= HUFF_APP_Data.MinSampleMicros ||
+            Iterations >= HUFF_APP_CALIB_MAX_ITERATIONS)
+        {
+            break;
+        }
+
+        Iterations *= 2;
+    }
+
+    return Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Check the kernels and set up what they run on                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static CFE_Status_t HUFF_APP_AbSetup(const HUFF_APP_AbCompare_Payload_t *Spec, HUFF_APP_AbSetup_t *Setup)
+{
+    bool BenchA = (Spec->KernelA == HUFF_APP_AbKernel_BENCH_LIB);
+    bool BenchB = (Spec->KernelB == HUFF_APP_AbKernel_BENCH_LIB);
+
+    memset(Setup, 0, sizeof(*Setup));
+
+    if (Spec->KernelA > HUFF_APP_AbKernel_PARALLEL || Spec->KernelB > HUFF_APP_AbKernel_PARALLEL ||
+        Spec->NumPairs < 2 || Spec->NumPairs > HUFF_APP_AB_MAX_PAIRS || Spec->Workers > HUFF_APP_PARDEC_MAX_WORKERS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_AB_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid A/B run: Kernels = %u/%u, Pairs = %u, Workers = %u",
+                          (unsigned int)Spec->KernelA, (unsigned int)Spec->KernelB, (unsigned int)Spec->NumPairs,
+                          (unsigned int)Spec->Workers);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    if (BenchA != BenchB)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_AB_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: bench_lib generates its own input, it can only be compared with itself");
+        return CFE_STATUS_RANGE_ERROR;
+    }
+    if (BenchA)
+    {
+        return CFE_SUCCESS;
+    }
+
+    Setup->Workload = HUFF_APP_WorkloadCurrent();
+    if (Setup->Workload == NULL)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_AB_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: In-app kernels need a corpus or generated input");
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    if (Spec->KernelA == HUFF_APP_AbKernel_PARALLEL || Spec->KernelB == HUFF_APP_AbKernel_PARALLEL)
+    {
+        if (Setup->Workload->IndexEntries == 0)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_AB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: The parallel kernel needs an indexed input");
+            return CFE_STATUS_INCORRECT_STATE;
+        }
+
+        Setup->Workers = (Spec->Workers != 0) ? Spec->Workers : HUFF_APP_PARDEC_MAX_WORKERS;
+
+        /* On a partial start, the parallel decode runs with the workers that did start */
+        HUFF_APP_ParDecStart(Setup->Workers);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Compare two kernels over Spec->NumPairs randomized ABBA quartets           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_AbRun(const HUFF_APP_AbCompare_Payload_t *Spec)
+{
+    HUFF_APP_AbSetup_t       Setup;
+    HUFF_APP_AbSample_t      Sample;
+    HUFF_APP_Report_t        Report;
+    HUFF_APP_AbKernel_Enum_t Kernel[2];
+    CFE_Status_t             status;
+    int64                    StartMicros;
+    uint32                   Iterations[2];
+    double                   QuartetNanos[2];
+    double                   SumNanos[2] = {0.0, 0.0};
+    double                   SumDiff     = 0.0;
+    double                   SumDiff2    = 0.0;
+    double                   MeanDiff    = 0.0;
+    double                   HalfWidth   = 0.0;
+    double                   Variance;
+    uint32                   Pairs         = 0;
+    uint32                   Disagreements = 0;
+    uint32                   Verdict;
+    uint32                   Slot;
+    uint32                   Side;
+    uint16                   Check[2];
+    uint16                   Order;
+    uint16                   Seed;
+    bool                     BFirst;
+
+    status = HUFF_APP_AbSetup(Spec, &Setup);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    Kernel[0]   = Spec->KernelA;
+    Kernel[1]   = Spec->KernelB;
+    StartMicros = HUFF_APP_GetTimeMicros();
+    Seed        = HUFF_APP_CurrentSeed();
+    Order       = (Spec->OrderSeed != 0) ? Spec->OrderSeed : (uint16)(StartMicros | 1);
+
+    Iterations[0] = HUFF_APP_AbCalibrate(&Setup, Kernel[0], Seed);
+    Iterations[1] = HUFF_APP_AbCalibrate(&Setup, Kernel[1], Seed);
+
+    while (Pairs < Spec->NumPairs && !HUFF_APP_ExecCancelled())
+    {
+        BFirst          = HUFF_APP_AbOrderBit(&Order);
+        QuartetNanos[0] = 0.0;
+        QuartetNanos[1] = 0.0;
+
+        for (Slot = 0; Slot < 4; Slot++)
+        {
+            /* Slots 0 and 3 run A in an ABBA quartet, B in a BAAB one */
+            Side = ((Slot == 0 || Slot == 3) == BFirst) ? 1 : 0;
+
+            HUFF_APP_AbSample(&Setup, Kernel[Side], Seed, Iterations[Side], &Sample);
+            if (Sample.Status != CFE_SUCCESS)
+            {
+                Disagreements++;
+            }
+            Check[Side] = Sample.Check;
+            QuartetNanos[Side] += ((double)Sample.DurationMicros * 1000.0) / Iterations[Side];
+        }
+
+        /* Both sides decoded the same seed, so their check values must match */
+        if (Check[0] != Check[1])
+        {
+            Disagreements++;
+        }
+
+        SumNanos[0] += QuartetNanos[0] / 2;
+        SumNanos[1] += QuartetNanos[1] / 2;
+        SumDiff += (QuartetNanos[0] - QuartetNanos[1]) / 2;
+        SumDiff2 += ((QuartetNanos[0] - QuartetNanos[1]) / 2) * ((QuartetNanos[0] - QuartetNanos[1]) / 2);
+        Pairs++;
+
+        /* Next seed of the chain; unused by the in-app kernels */
+        Seed = Check[0];
+    }
+
+    if (Pairs >= 2)
+    {
+        MeanDiff = SumDiff / Pairs;
+        Variance = (SumDiff2 - SumDiff * MeanDiff) / (Pairs - 1);
+        HalfWidth =
+            (HUFF_APP_StudentT95Milli(Pairs - 1) / 1000.0) * sqrt((Variance > 0.0) ? Variance / Pairs : 0.0);
+    }
+
+    if (Disagreements != 0 || Pairs < 2)
+    {
+        Verdict = HUFF_APP_AB_MISMATCH;
+
+        CFE_EVS_SendEvent(HUFF_APP_AB_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: A/B run of kernels %u/%u: %lu failed or disagreeing runs in %lu quartets",
+                          (unsigned int)Kernel[0], (unsigned int)Kernel[1], (unsigned long)Disagreements,
+                          (unsigned long)Pairs);
+    }
+    else
+    {
+        if (MeanDiff + HalfWidth < 0.0)
+        {
+            Verdict = HUFF_APP_AB_A_FASTER;
+        }
+        else if (MeanDiff - HalfWidth > 0.0)
+        {
+            Verdict = HUFF_APP_AB_B_FASTER;
+        }
+        else
+        {
+            Verdict = HUFF_APP_AB_SAME;
+        }
+
+        CFE_EVS_SendEvent(HUFF_APP_AB_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "HUFF: A/B run of kernels %u/%u: A - B = %ld ns +/- %lu ns (95%%), verdict %u",
+                          (unsigned int)Kernel[0], (unsigned int)Kernel[1], (long)MeanDiff,
+                          (unsigned long)HalfWidth, (unsigned int)Verdict);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUAB");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, Kernel[0]);
+    HUFF_APP_ReportAddU32(&Report, Kernel[1]);
+    HUFF_APP_ReportAddU32(&Report, Setup.Workers);
+    HUFF_APP_ReportAddU32(&Report, Pairs);
+    HUFF_APP_ReportAddU32(&Report, Iterations[0]);
+    HUFF_APP_ReportAddU32(&Report, Iterations[1]);
+    HUFF_APP_ReportAddU32(&Report, (Pairs != 0) ? (uint32)(SumNanos[0] / Pairs) : 0);
+    HUFF_APP_ReportAddU32(&Report, (Pairs != 0) ? (uint32)(SumNanos[1] / Pairs) : 0);
+    HUFF_APP_ReportAddS32(&Report, (int32)MeanDiff);
+    HUFF_APP_ReportAddU32(&Report, (uint32)HalfWidth);
+    HUFF_APP_ReportAddU32(&Report, Verdict);
+    HUFF_APP_ReportAddU32(&Report, Disagreements);
+    HUFF_APP_ReportSend(&Report);
+
+    return CFE_SUCCESS;
+}
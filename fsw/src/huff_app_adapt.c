@@ -0,0 +1,251 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App adaptive stopping rule.
+ *
+ *   Guarded samples of the bench_lib benchmark are taken on the seed chain
+ *   until the 95% confidence interval of the time per invocation is narrower
+ *   than the commanded target, relative to the estimate, or the time budget
+ *   runs out. The mean uses a Student t interval; the median uses the
+ *   distribution-free interval between two order statistics, which needs no
+ *   assumption on the (often skewed) distribution of the samples. The
+ *   samples are kept sorted as they come, so both are cheap to update.
+ */
+
+/*
+** Include Files:
+*/
+#include <math.h>
+
+#include "huff_app.h"
+#include "huff_app_adapt.h"
+#include "huff_app_bench.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_replay.h"
+#include "huff_app_utils.h"
+
+/*
+** Estimate of the statistic and its 95% interval
+*/
+typedef struct
+{
+    double EstimateNanos;
+    double HalfWidthNanos; /* Half the interval, HUGE_VAL while too few samples */
+} HUFF_APP_AdaptEstimate_t;
+
+typedef struct
+{
+    /* Times per invocation, sorted, too large for the executor stack */
+    uint32 Nanos[HUFF_APP_ADAPT_MAX_SAMPLES];
+    uint32 Count;
+    double Sum;
+    double SumSquares;
+} HUFF_APP_AdaptData_t;
+
+static HUFF_APP_AdaptData_t HUFF_APP_AdaptData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Insert a time per invocation, keeping the samples sorted        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HUFF_APP_AdaptAdd(uint32 Nanos)
+{
+    HUFF_APP_AdaptData_t *Data = &HUFF_APP_AdaptData;
+    uint32                i;
+
+    for (i = Data->Count; i > 0 && Data->Nanos[i - 1] > Nanos; i--)
+    {
+        Data->Nanos[i] = Data->Nanos[i - 1];
+    }
+    Data->Nanos[i] = Nanos;
+    Data->Count++;
+
+    Data->Sum += Nanos;
+    Data->SumSquares += (double)Nanos * Nanos;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Current estimate and 95% interval of the selected statistic     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HUFF_APP_AdaptEstimate(HUFF_APP_AdaptStat_Enum_t Statistic, HUFF_APP_AdaptEstimate_t *Estimate)
+{
+    const HUFF_APP_AdaptData_t *Data = &HUFF_APP_AdaptData;
+    double                      n    = Data->Count;
+    double                      Variance;
+    double                      Spread;
+    int32                       Lo;
+    int32                       Hi;
+
+    Estimate->EstimateNanos  = 0.0;
+    Estimate->HalfWidthNanos = HUGE_VAL;
+
+    if (Data->Count == 0)
+    {
+        return;
+    }
+
+    if (Statistic == HUFF_APP_AdaptStat_MEAN)
+    {
+        Estimate->EstimateNanos = Data->Sum / n;
+        if (Data->Count >= 2)
+        {
+            Variance = (Data->SumSquares - Data->Sum * Estimate->EstimateNanos) / (n - 1);
+            Estimate->HalfWidthNanos =
+                (HUFF_APP_StudentT95Milli(Data->Count - 1) / 1000.0) * sqrt((Variance > 0.0) ? Variance / n : 0.0);
+        }
+        return;
+    }
+
+    if (Data->Count & 1)
+    {
+        Estimate->EstimateNanos = Data->Nanos[Data->Count / 2];
+    }
+    else
+    {
+        Estimate->EstimateNanos = ((double)Data->Nanos[Data->Count / 2 - 1] + Data->Nanos[Data->Count / 2]) / 2;
+    }
+
+    /*
+    ** The number of samples below the median is Binomial(n, 1/2): the ranks
+    ** n/2 -/+ 1.96 sqrt(n)/2 (normal approximation, 1-based) bound it at 95%
+    */
+    Spread = 0.98 * sqrt(n);
+    Lo     = (int32)floor(n / 2 - Spread);
+    Hi     = (int32)ceil(n / 2 + 1 + Spread);
+    if (Lo >= 1 && Hi <= (int32)Data->Count)
+    {
+        Estimate->HalfWidthNanos = ((double)Data->Nanos[Hi - 1] - Data->Nanos[Lo - 1]) / 2;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Sample until the interval of the statistic is within the target, or the    */
+/* time budget is spent                                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_AdaptRun(const HUFF_APP_AdaptiveRun_Payload_t *Spec)
+{
+    HUFF_APP_AdaptData_t    *Data = &HUFF_APP_AdaptData;
+    HUFF_APP_AdaptEstimate_t Estimate;
+    HUFF_APP_Sample_t        Sample;
+    HUFF_APP_Report_t        Report;
+    int64                    StartMicros;
+    int64                    ElapsedMicros = 0;
+    uint32                   BudgetMillis;
+    uint32                   Failures = 0;
+    uint32                   AchievedPpm;
+    bool                     Met = false;
+    uint16                   Seed;
+
+    if (Spec->TargetPpm == 0 || Spec->TargetPpm >= 1000000 || Spec->Statistic > HUFF_APP_AdaptStat_MEDIAN)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_ADAPT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid adaptive run: Target = %lu ppm, Statistic = %u",
+                          (unsigned long)Spec->TargetPpm, (unsigned int)Spec->Statistic);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+    if (HUFF_APP_Data.InputMode != HUFF_APP_InputMode_SEED)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_ADAPT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Adaptive runs time the bench_lib kernel, select the seed input mode");
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    BudgetMillis = (Spec->BudgetMillis != 0) ? Spec->BudgetMillis : HUFF_APP_ADAPT_DEFAULT_BUDGET;
+
+    memset(Data, 0, sizeof(*Data));
+    Estimate.EstimateNanos  = 0.0;
+    Estimate.HalfWidthNanos = HUGE_VAL;
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+    Seed        = HUFF_APP_CurrentSeed();
+
+    while (Data->Count < HUFF_APP_ADAPT_MAX_SAMPLES && ElapsedMicros < (int64)BudgetMillis * 1000 &&
+           !HUFF_APP_ExecCancelled())
+    {
+        HUFF_APP_BenchGuardedSample(Seed, HUFF_APP_Data.IterationCount, &Sample);
+        HUFF_APP_ReplayLog(&Sample);
+        Seed          = Sample.CheckD;
+        ElapsedMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+
+        if (Sample.Status != CFE_SUCCESS || Sample.Unstable)
+        {
+            Failures++;
+            continue;
+        }
+
+        HUFF_APP_AdaptAdd(HUFF_APP_SampleNanosPerIteration(&Sample));
+        if (Data->Count < HUFF_APP_ADAPT_MIN_SAMPLES)
+        {
+            continue;
+        }
+
+        HUFF_APP_AdaptEstimate(Spec->Statistic, &Estimate);
+        if (Estimate.HalfWidthNanos * 1000000.0 <= Estimate.EstimateNanos * Spec->TargetPpm)
+        {
+            Met = true;
+            break;
+        }
+    }
+
+    HUFF_APP_AdaptEstimate(Spec->Statistic, &Estimate);
+    AchievedPpm = 0xFFFFFFFF;
+    if (Estimate.EstimateNanos > 0.0 && Estimate.HalfWidthNanos < Estimate.EstimateNanos * 4294.0)
+    {
+        AchievedPpm = (uint32)((Estimate.HalfWidthNanos * 1000000.0) / Estimate.EstimateNanos);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUAD");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, Spec->Statistic);
+    HUFF_APP_ReportAddU32(&Report, Spec->TargetPpm);
+    HUFF_APP_ReportAddU32(&Report, BudgetMillis);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.IterationCount);
+    HUFF_APP_ReportAddU32(&Report, Data->Count);
+    HUFF_APP_ReportAddU32(&Report, Failures);
+    HUFF_APP_ReportAddU32(&Report, ElapsedMicros / 1000);
+    HUFF_APP_ReportAddU32(&Report, (uint32)Estimate.EstimateNanos);
+    HUFF_APP_ReportAddU32(&Report, (Estimate.HalfWidthNanos < 4294967295.0) ? (uint32)Estimate.HalfWidthNanos
+                                                                            : 0xFFFFFFFF);
+    HUFF_APP_ReportAddU32(&Report, AchievedPpm);
+    HUFF_APP_ReportAddU32(&Report, Met);
+    HUFF_APP_ReportSend(&Report);
+
+    if (Data->Count == 0)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_ADAPT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Adaptive run has no valid sample, %lu failed", (unsigned long)Failures);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_ADAPT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Adaptive run %s after %lu samples in %lu ms: %lu ns, +/- %lu ppm",
+                      Met ? "converged" : "stopped by its budget", (unsigned long)Data->Count,
+                      (unsigned long)(ElapsedMicros / 1000), (unsigned long)Estimate.EstimateNanos,
+                      (unsigned long)AchievedPpm);
+
+    return CFE_SUCCESS;
+}
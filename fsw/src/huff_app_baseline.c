@@ -0,0 +1,433 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App baseline comparison.
+ *
+ *   A batch is a series of guarded benchmark samples on the seed chain,
+ *   summarized by the median and the median absolute deviation (MAD) of the
+ *   time per invocation, which a few preempted or throttled samples cannot
+ *   move. Each build configuration (compiler flags and cache settings) has
+ *   its own baseline in a cFE table. A batch either records itself as the
+ *   baseline of the running configuration, or is compared against it with a
+ *   robust z score: the difference of the medians over their standard error,
+ *   estimated from the two MADs.
+ */
+
+/*
+** Include Files:
+*/
+#include <math.h>
+#include <stdlib.h>
+
+#include "huff_app.h"
+#include "huff_app_baseline.h"
+#include "huff_app_bench.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_tbl.h"
+#include "huff_app_utils.h"
+
+#include "bench_lib.h"
+
+#include "cfe_tbl_msg.h"
+#include "cfe_tbl_msgids.h"
+
+/*
+** Standard deviation of a normal distribution over its MAD, and standard
+** error of the median over that of the mean for large samples (sqrt(pi/2))
+*/
+#define HUFF_APP_BASELINE_MAD_TO_SIGMA   1.4826
+#define HUFF_APP_BASELINE_MEDIAN_SE      1.2533
+
+typedef struct
+{
+    CFE_TBL_Handle_t TblHandle;
+
+    /* Work arrays of the batch, too large for the executor stack */
+    uint32 Nanos[HUFF_APP_BATCH_MAX_RUNS];
+    uint32 Deviation[HUFF_APP_BATCH_MAX_RUNS];
+} HUFF_APP_BaselineData_t;
+
+static HUFF_APP_BaselineData_t HUFF_APP_BaselineData;
+
+extern HUFF_APP_BaselineTable_t HUFF_APP_BaselineDefaultTable;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Verify the baseline table contents                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HUFF_APP_BaselineValidationFunc(void *TblData)
+{
+    const HUFF_APP_BaselineTable_t *TblDataPtr = (const HUFF_APP_BaselineTable_t *)TblData;
+    const HUFF_APP_BaselineEntry_t *Entry;
+    uint32                          i;
+    uint32                          j;
+
+    if (TblDataPtr->ZThresholdMilli == 0 || TblDataPtr->MinDeltaPermille >= 1000)
+    {
+        return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    for (i = 0; i < HUFF_APP_BASELINE_MAX_ENTRIES; i++)
+    {
+        Entry = &TblDataPtr->Entry[i];
+        if (!Entry->Valid)
+        {
+            continue;
+        }
+
+        if (Entry->Samples == 0 || Entry->Samples > HUFF_APP_BATCH_MAX_RUNS || Entry->MedianNanos == 0)
+        {
+            return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+
+        /* One baseline per configuration, or the lookup would be ambiguous */
+        for (j = i + 1; j < HUFF_APP_BASELINE_MAX_ENTRIES; j++)
+        {
+            if (TblDataPtr->Entry[j].Valid && TblDataPtr->Entry[j].BuildFlags == Entry->BuildFlags &&
+                TblDataPtr->Entry[j].CacheSettings == Entry->CacheSettings)
+            {
+                return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Register the baseline table and load its default                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t HUFF_APP_BaselineInit(void)
+{
+    CFE_Status_t status;
+    os_fstat_t   TableStat;
+
+    memset(&HUFF_APP_BaselineData, 0, sizeof(HUFF_APP_BaselineData));
+
+    status = CFE_TBL_Register(&HUFF_APP_BaselineData.TblHandle, "BaselineTable", sizeof(HUFF_APP_BaselineTable_t),
+                              CFE_TBL_OPT_DEFAULT, HUFF_APP_BaselineValidationFunc);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    /* The baselines stored by the last recording when there are any, the empty table otherwise */
+    if (OS_stat(HUFF_APP_BASELINE_TABLE_FILE, &TableStat) == OS_SUCCESS)
+    {
+        status = CFE_TBL_Load(HUFF_APP_BaselineData.TblHandle, CFE_TBL_SRC_FILE, HUFF_APP_BASELINE_TABLE_FILE);
+    }
+    else
+    {
+        status = CFE_TBL_Load(HUFF_APP_BaselineData.TblHandle, CFE_TBL_SRC_ADDRESS, &HUFF_APP_BaselineDefaultTable);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Have Table Services dump the active table over its /cf image    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static CFE_Status_t HUFF_APP_BaselineSave(void)
+{
+    CFE_TBL_DumpCmd_t DumpCmd;
+
+    memset(&DumpCmd, 0, sizeof(DumpCmd));
+    DumpCmd.Payload.ActiveTableFlag = CFE_TBL_BufferSelect_ACTIVE;
+    strncpy(DumpCmd.Payload.TableName, HUFF_APP_BASELINE_TABLE_NAME, sizeof(DumpCmd.Payload.TableName) - 1);
+    strncpy(DumpCmd.Payload.DumpFilename, HUFF_APP_BASELINE_TABLE_FILE, sizeof(DumpCmd.Payload.DumpFilename) - 1);
+
+    CFE_MSG_Init(CFE_MSG_PTR(DumpCmd.CommandHeader), CFE_SB_ValueToMsgId(CFE_TBL_CMD_MID), sizeof(DumpCmd));
+    CFE_MSG_SetFcnCode(CFE_MSG_PTR(DumpCmd.CommandHeader), CFE_TBL_DUMP_CC);
+    CFE_MSG_GenerateChecksum(CFE_MSG_PTR(DumpCmd.CommandHeader));
+
+    return CFE_SB_TransmitMsg(CFE_MSG_PTR(DumpCmd.CommandHeader), true);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Manage pending loads and dumps of the baseline table            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_BaselineManage(void)
+{
+    CFE_TBL_Manage(HUFF_APP_BaselineData.TblHandle);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Entry of the running build configuration, or the first free     */
+/* entry when it has none and Allocate is set                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static HUFF_APP_BaselineEntry_t *HUFF_APP_BaselineLookup(HUFF_APP_BaselineTable_t *Table, bool Allocate)
+{
+    HUFF_APP_BaselineEntry_t *Free = NULL;
+    uint8                     BuildFlags;
+    uint8                     CacheSettings;
+    uint32                    i;
+
+    BuildFlags    = BENCH_LIB_u8BuildFlags();
+    CacheSettings = BENCH_LIB_u8GetCacheSettings();
+
+    for (i = 0; i < HUFF_APP_BASELINE_MAX_ENTRIES; i++)
+    {
+        if (!Table->Entry[i].Valid)
+        {
+            if (Free == NULL)
+            {
+                Free = &Table->Entry[i];
+            }
+        }
+        else if (Table->Entry[i].BuildFlags == BuildFlags && Table->Entry[i].CacheSettings == CacheSettings)
+        {
+            return &Table->Entry[i];
+        }
+    }
+
+    return Allocate ? Free : NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Robust z score of a batch against its baseline, in hundredths,  */
+/* positive when the batch is slower                               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 HUFF_APP_BaselineZ(const HUFF_APP_BaselineEntry_t *Base, uint32 Samples, uint32 MedianNanos,
+                                uint32 MadNanos)
+{
+    double BatchMad;
+    double BaseMad;
+    double StdErr;
+    double Z100;
+
+    /* A MAD of zero (timer coarser than the spread) would make any change infinitely significant */
+    BatchMad = (MadNanos > 0) ? MadNanos : 1.0;
+    BaseMad  = (Base->MadNanos > 0) ? Base->MadNanos : 1.0;
+
+    StdErr = HUFF_APP_BASELINE_MEDIAN_SE * HUFF_APP_BASELINE_MAD_TO_SIGMA *
+             sqrt((BatchMad * BatchMad) / Samples + (BaseMad * BaseMad) / Base->Samples);
+
+    Z100 = (((double)MedianNanos - (double)Base->MedianNanos) * 100.0) / StdErr;
+
+    /* In range of the cast, and of the permille comparison made with it */
+    if (Z100 > INT32_MAX / 10)
+    {
+        Z100 = INT32_MAX / 10;
+    }
+    else if (Z100 < -(INT32_MAX / 10))
+    {
+        Z100 = -(INT32_MAX / 10);
+    }
+
+    return (int32)Z100;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Run a batch of NumRuns samples, then record it as the baseline of this     */
+/* build or compare it against that baseline                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_BaselineRun(uint16 NumRuns, bool Record)
+{
+    HUFF_APP_BaselineData_t  *Data = &HUFF_APP_BaselineData;
+    HUFF_APP_BaselineTable_t *Table;
+    HUFF_APP_BaselineEntry_t *Entry;
+    HUFF_APP_BaselineEntry_t  Base;
+    HUFF_APP_Sample_t         Sample;
+    HUFF_APP_Report_t         Report;
+    CFE_Status_t              status;
+    int64                     StartMicros;
+    uint32                    Count;
+    uint32                    Failures;
+    uint32                    MedianNanos;
+    uint32                    MadNanos;
+    uint32                    ZThresholdMilli;
+    uint32                    MinDeltaPermille;
+    uint32                    RatioPermille = 0;
+    uint64                    Ratio;
+    uint32                    Verdict;
+    int32                     Z100 = 0;
+    uint16                    Seed;
+    uint32                    i;
+
+    if (HUFF_APP_Data.InputMode != HUFF_APP_InputMode_SEED)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Baselines are kept for the bench_lib kernel, select the seed input mode");
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    memset(&Base, 0, sizeof(Base));
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+    Seed        = HUFF_APP_CurrentSeed();
+    Count       = 0;
+    Failures    = 0;
+
+    for (i = 0; i < NumRuns && !HUFF_APP_ExecCancelled(); i++)
+    {
+        HUFF_APP_BenchGuardedSample(Seed, HUFF_APP_Data.IterationCount, &Sample);
+        Seed = Sample.CheckD;
+
+        /* Failed or rejected samples would bias the distribution */
+        if (Sample.Status != CFE_SUCCESS || Sample.Unstable)
+        {
+            Failures++;
+            continue;
+        }
+
+        Data->Nanos[Count++] = HUFF_APP_SampleNanosPerIteration(&Sample);
+    }
+
+    if (Count == 0)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Batch has no valid sample, %lu failed", (unsigned long)Failures);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    MedianNanos = HUFF_APP_MedianU32(Data->Nanos, Count);
+    for (i = 0; i < Count; i++)
+    {
+        Data->Deviation[i] =
+            (Data->Nanos[i] > MedianNanos) ? (Data->Nanos[i] - MedianNanos) : (MedianNanos - Data->Nanos[i]);
+    }
+    MadNanos = HUFF_APP_MedianU32(Data->Deviation, Count);
+
+    status = CFE_TBL_GetAddress((void **)&Table, Data->TblHandle);
+    if (status != CFE_SUCCESS && status != CFE_TBL_INFO_UPDATED)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to get the baseline table, RC = 0x%08lX", (unsigned long)status);
+        return status;
+    }
+
+    Entry = HUFF_APP_BaselineLookup(Table, Record);
+    if (Entry != NULL)
+    {
+        if (Record)
+        {
+            Entry->Valid         = 1;
+            Entry->BuildFlags    = BENCH_LIB_u8BuildFlags();
+            Entry->CacheSettings = BENCH_LIB_u8GetCacheSettings();
+            Entry->Samples       = Count;
+            Entry->MedianNanos   = MedianNanos;
+            Entry->MadNanos      = MadNanos;
+        }
+        Base = *Entry;
+    }
+    ZThresholdMilli  = Table->ZThresholdMilli;
+    MinDeltaPermille = Table->MinDeltaPermille;
+
+    CFE_TBL_ReleaseAddress(Data->TblHandle);
+
+    if (Record)
+    {
+        if (Entry == NULL)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Baseline table full, %u build configurations stored",
+                              (unsigned int)HUFF_APP_BASELINE_MAX_ENTRIES);
+            return CFE_STATUS_RANGE_ERROR;
+        }
+
+        /* Lets Table Services know the contents changed, then stores them for the next start */
+        CFE_TBL_Modified(Data->TblHandle);
+        status = HUFF_APP_BaselineSave();
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Failed to request the baseline table dump, RC = 0x%08lX", (unsigned long)status);
+        }
+        Verdict = HUFF_APP_BASELINE_RECORDED;
+
+        CFE_EVS_SendEvent(HUFF_APP_BASE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "HUFF: Baseline recorded: %lu samples, median %lu ns, MAD %lu ns", (unsigned long)Count,
+                          (unsigned long)MedianNanos, (unsigned long)MadNanos);
+    }
+    else if (Entry == NULL)
+    {
+        Verdict = HUFF_APP_BASELINE_MISSING;
+
+        CFE_EVS_SendEvent(HUFF_APP_BASE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "HUFF: No baseline for this build: %lu samples, median %lu ns, MAD %lu ns",
+                          (unsigned long)Count, (unsigned long)MedianNanos, (unsigned long)MadNanos);
+    }
+    else
+    {
+        Ratio         = ((uint64)MedianNanos * 1000) / Base.MedianNanos;
+        RatioPermille = (Ratio > UINT32_MAX) ? UINT32_MAX : (uint32)Ratio;
+        Z100          = HUFF_APP_BaselineZ(&Base, Count, MedianNanos, MadNanos);
+
+        /* Significant, and large enough to matter */
+        if ((uint32)abs(Z100) * 10 < ZThresholdMilli ||
+            (RatioPermille > 1000 ? RatioPermille - 1000 : 1000 - RatioPermille) < MinDeltaPermille)
+        {
+            Verdict = HUFF_APP_BASELINE_SAME;
+
+            CFE_EVS_SendEvent(HUFF_APP_BASE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "HUFF: No change: median %lu ns vs %lu ns, z = %ld/100", (unsigned long)MedianNanos,
+                              (unsigned long)Base.MedianNanos, (long)Z100);
+        }
+        else if (Z100 > 0)
+        {
+            Verdict = HUFF_APP_BASELINE_REGRESSION;
+
+            CFE_EVS_SendEvent(HUFF_APP_REGRESS_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Regression: median %lu ns vs %lu ns (%lu permille), z = %ld/100",
+                              (unsigned long)MedianNanos, (unsigned long)Base.MedianNanos,
+                              (unsigned long)RatioPermille, (long)Z100);
+        }
+        else
+        {
+            Verdict = HUFF_APP_BASELINE_IMPROVEMENT;
+
+            CFE_EVS_SendEvent(HUFF_APP_BASE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "HUFF: Improvement: median %lu ns vs %lu ns (%lu permille), z = %ld/100",
+                              (unsigned long)MedianNanos, (unsigned long)Base.MedianNanos,
+                              (unsigned long)RatioPermille, (long)Z100);
+        }
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUBL");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, Count);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.IterationCount);
+    HUFF_APP_ReportAddU32(&Report, MedianNanos);
+    HUFF_APP_ReportAddU32(&Report, MadNanos);
+    HUFF_APP_ReportAddU32(&Report, Base.MedianNanos);
+    HUFF_APP_ReportAddU32(&Report, Base.MadNanos);
+    HUFF_APP_ReportAddU32(&Report, RatioPermille);
+    HUFF_APP_ReportAddU32(&Report, (uint32)abs(Z100));
+    HUFF_APP_ReportAddU32(&Report, Verdict);
+    HUFF_APP_ReportAddU32(&Report, Failures);
+    HUFF_APP_ReportSend(&Report);
+
+    return CFE_SUCCESS;
+}
@@ -0,0 +1,49 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App baseline comparison
+ */
+
+#ifndef HUFF_APP_BASELINE_H
+#define HUFF_APP_BASELINE_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+
+/*
+** Outcome of a batch, as reported in its result sentence
+*/
+enum
+{
+    HUFF_APP_BASELINE_SAME        = 0, /* No significant change */
+    HUFF_APP_BASELINE_REGRESSION  = 1,
+    HUFF_APP_BASELINE_IMPROVEMENT = 2,
+    HUFF_APP_BASELINE_MISSING     = 3, /* No baseline for this build */
+    HUFF_APP_BASELINE_RECORDED    = 4
+};
+
+int32        HUFF_APP_BaselineValidationFunc(void *TblData);
+CFE_Status_t HUFF_APP_BaselineInit(void);
+void         HUFF_APP_BaselineManage(void);
+CFE_Status_t HUFF_APP_BaselineRun(uint16 NumRuns, bool Record);
+
+#endif /* HUFF_APP_BASELINE_H */
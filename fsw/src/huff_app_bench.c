@@ -0,0 +1,249 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App benchmark sampling functions
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_bench.h"
+#include "huff_app_eventids.h"
+#include "huff_app_runstat.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+
+/* The bench_lib module provides the benchmark functions prototypes */
+#include "bench_lib.h"
+
+/* Keeps the result of the stability loop alive */
+static volatile uint32 HUFF_APP_GuardSink;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Seed of the next run, as the majority of the three randomizing seeds       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint16 HUFF_APP_CurrentSeed(void)
+{
+    return BENCH_LIB_u16Maj(HUFF_APP_Data.RandomizingSeed_1, HUFF_APP_Data.RandomizingSeed_2,
+                            HUFF_APP_Data.RandomizingSeed_3);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Run and time Iterations chained benchmark invocations from the given seed  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_BenchSample(uint16 Seed, uint32 Iterations, HUFF_APP_Sample_t *Sample)
+{
+    HUFF_APP_PerfCtrValues_t CountersBefore;
+    HUFF_APP_PerfCtrValues_t CountersAfter;
+    int64                    EndMicros;
+    int32                    status;
+    uint32                   i;
+
+    memset(Sample, 0, sizeof(*Sample));
+    Sample->Seed       = Seed;
+    Sample->Status     = CFE_SUCCESS;
+    Sample->Iterations = (Iterations == 0) ? 1 : Iterations;
+    Sample->CheckD     = Seed;
+
+    /* Counters are read outside the timed region */
+    HUFF_APP_PerfCtrRead(&CountersBefore);
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DECODE);
+    Sample->StartMicros = HUFF_APP_GetTimeMicros();
+
+    for (i = 0; i < Sample->Iterations; i++)
+    {
+        /* Invoke the benchmark function provided by Benchmark library */
+        status = BENCH_LIB_HuffBenchTask(Sample->CheckD, &Sample->Table, &Sample->CheckE, &Sample->CheckD);
+        if (status != CFE_SUCCESS && Sample->Status == CFE_SUCCESS)
+        {
+            Sample->Status = status;
+        }
+
+        /* The one invocation the seed reported with the sample checks against */
+        if (i == 0)
+        {
+            Sample->FirstTable  = Sample->Table;
+            Sample->FirstCheckE = Sample->CheckE;
+            Sample->FirstCheckD = Sample->CheckD;
+        }
+    }
+
+    EndMicros = HUFF_APP_GetTimeMicros();
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_DECODE);
+
+    HUFF_APP_PerfCtrRead(&CountersAfter);
+
+    Sample->DurationMicros = EndMicros - Sample->StartMicros;
+    HUFF_APP_PerfCtrDelta(&CountersBefore, &CountersAfter, &Sample->Counters);
+
+    HUFF_APP_RunStatDecoded((uint64)HUFF_APP_BENCH_TASK_BYTES * Sample->Iterations,
+                            (uint64)HUFF_APP_BENCH_TASK_BYTES * Sample->Iterations);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Time per benchmark invocation of a sample, in nanoseconds                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_SampleNanosPerIteration(const HUFF_APP_Sample_t *Sample)
+{
+    return (uint32)((Sample->DurationMicros * 1000) / Sample->Iterations);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Double the iteration count until one timed sample lasts at least           */
+/* MinSampleMicros, then cache the result for the following runs              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_BenchCalibrate(uint32 MinSampleMicros)
+{
+    HUFF_APP_Sample_t Sample;
+    uint32            Iterations = 1;
+
+    if (MinSampleMicros == 0)
+    {
+        MinSampleMicros = HUFF_APP_CALIB_MIN_SAMPLE_US;
+    }
+
+    /* The first invocation only warms up caches and branch predictors */
+    HUFF_APP_BenchSample(HUFF_APP_CurrentSeed(), 1, &Sample);
+
+    while (true)
+    {
+        HUFF_APP_BenchSample(HUFF_APP_CurrentSeed(), Iterations, &Sample);
+
+        if (Sample.DurationMicros >= MinSampleMicros || Iterations >= HUFF_APP_CALIB_MAX_ITERATIONS)
+        {
+            break;
+        }
+
+        Iterations *= 2;
+    }
+
+    HUFF_APP_Data.IterationCount  = Iterations;
+    HUFF_APP_Data.MinSampleMicros = MinSampleMicros;
+
+    CFE_EVS_SendEvent(HUFF_APP_CALIB_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Calibrated %lu iterations per sample, %ld us per sample, %lu ns per iteration",
+                      (unsigned long)Iterations, (long)Sample.DurationMicros,
+                      (unsigned long)HUFF_APP_SampleNanosPerIteration(&Sample));
+
+    return Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Time a fixed dependent multiply-add loop. Its duration only depends on     */
+/* the CPU clock, so a change across a sample reveals a frequency change.     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int64 HUFF_APP_GuardLoopMicros(void)
+{
+    uint32 Acc = 1;
+    uint32 i;
+    int64  StartMicros;
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    for (i = 0; i < HUFF_APP_GUARD_LOOP_ITERATIONS; i++)
+    {
+        Acc = Acc * 0x9E3779B1u + i;
+    }
+    HUFF_APP_GuardSink = Acc;
+
+    return HUFF_APP_GetTimeMicros() - StartMicros;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Take a sample bracketed by the stability loop. In reject mode, unstable    */
+/* samples are discarded and retried a bounded number of times.              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_BenchGuardedSample(uint16 Seed, uint32 Iterations, HUFF_APP_Sample_t *Sample)
+{
+    int64  PreMicros;
+    int64  PostMicros;
+    int64  Shortest;
+    int64  Difference;
+    uint32 Retries = 0;
+
+    while (true)
+    {
+        if (HUFF_APP_Data.GuardMode == HUFF_APP_GuardMode_OFF)
+        {
+            HUFF_APP_BenchSample(Seed, Iterations, Sample);
+            return;
+        }
+
+        PreMicros = HUFF_APP_GuardLoopMicros();
+        HUFF_APP_BenchSample(Seed, Iterations, Sample);
+        PostMicros = HUFF_APP_GuardLoopMicros();
+
+        Shortest   = (PreMicros < PostMicros) ? PreMicros : PostMicros;
+        Difference = (PreMicros < PostMicros) ? (PostMicros - PreMicros) : (PreMicros - PostMicros);
+
+        Sample->GuardPreMicros  = PreMicros;
+        Sample->GuardPostMicros = PostMicros;
+        Sample->DriftPermille   = (Shortest > 0) ? (uint32)((Difference * 1000) / Shortest) : 0;
+        Sample->Unstable        = (Sample->DriftPermille > HUFF_APP_Data.GuardTolerancePermille);
+        Sample->Retries         = Retries;
+
+        if (!Sample->Unstable)
+        {
+            return;
+        }
+
+        if (HUFF_APP_Data.GuardMode != HUFF_APP_GuardMode_REJECT || Retries >= HUFF_APP_GUARD_MAX_RETRIES)
+        {
+            HUFF_APP_Data.FlaggedSampleCount++;
+            return;
+        }
+
+        HUFF_APP_Data.RejectedSampleCount++;
+        Retries++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Estimated CPU cycles per benchmark invocation, using the stability loop    */
+/* as a clock of known cycle count. Returns 0 for unguarded samples.          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_SampleCyclesPerIteration(const HUFF_APP_Sample_t *Sample)
+{
+    uint64 LoopMicros = (uint64)(Sample->GuardPreMicros + Sample->GuardPostMicros) / 2;
+    uint64 LoopCycles = (uint64)HUFF_APP_GUARD_LOOP_ITERATIONS * HUFF_APP_GUARD_CYCLES_PER_ITERATION;
+
+    if (LoopMicros == 0)
+    {
+        return 0;
+    }
+
+    return (uint32)(((uint64)Sample->DurationMicros * LoopCycles) / (LoopMicros * Sample->Iterations));
+}
@@ -0,0 +1,69 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App benchmark sampling functions
+ */
+
+#ifndef HUFF_APP_BENCH_H
+#define HUFF_APP_BENCH_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_perfctr.h"
+
+/*
+** One timed sample of back-to-back bench_lib Huffman benchmark invocations,
+** each invocation seeded with the decoder check value of the previous one
+*/
+typedef struct
+{
+    uint16 Seed;           /* Randomizing seed the sample was started with */
+    uint8  FirstTable;     /* Code table selected by bench_lib in the first invocation */
+    uint16 FirstCheckE;    /* Encoder check value of the first invocation */
+    uint16 FirstCheckD;    /* Decoder check value of the first invocation (next seed of the run sequence) */
+    uint8  Table;          /* Code table selected by bench_lib in the last invocation */
+    uint16 CheckE;         /* Encoder check value of the last invocation */
+    uint16 CheckD;         /* Decoder check value of the last invocation (next seed of the chain) */
+    int32  Status;         /* First failing bench_lib return code, CFE_SUCCESS otherwise */
+    uint32 Iterations;     /* Number of invocations in the sample */
+    int64  StartMicros;    /* PSP time at the start of the sample */
+    int64  DurationMicros; /* Elapsed time of the sample */
+
+    HUFF_APP_PerfCtrValues_t Counters; /* Performance counter increments over the sample */
+
+    /* Stability guard, filled in by HUFF_APP_BenchGuardedSample() only */
+    int64  GuardPreMicros;   /* Fixed loop time before the sample */
+    int64  GuardPostMicros;  /* Fixed loop time after the sample */
+    uint32 DriftPermille;    /* Relative loop time change across the sample */
+    bool   Unstable;         /* Drift exceeded the tolerance */
+    uint32 Retries;          /* Samples discarded before this one */
+} HUFF_APP_Sample_t;
+
+uint16 HUFF_APP_CurrentSeed(void);
+void   HUFF_APP_BenchSample(uint16 Seed, uint32 Iterations, HUFF_APP_Sample_t *Sample);
+uint32 HUFF_APP_SampleNanosPerIteration(const HUFF_APP_Sample_t *Sample);
+uint32 HUFF_APP_BenchCalibrate(uint32 MinSampleMicros);
+int64  HUFF_APP_GuardLoopMicros(void);
+void   HUFF_APP_BenchGuardedSample(uint16 Seed, uint32 Iterations, HUFF_APP_Sample_t *Sample);
+uint32 HUFF_APP_SampleCyclesPerIteration(const HUFF_APP_Sample_t *Sample);
+
+#endif /* HUFF_APP_BENCH_H */
@@ -0,0 +1,238 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App code book cache.
+ *
+ *   Histograms are quantized to the rounded -log2 of each symbol
+ *   probability, which is about the code length the symbol would get, and
+ *   hashed with FNV-1a. A lookup first looks for an entry with the same
+ *   quantized table, then for the closest one: the one whose quantized code
+ *   lengths differ the least on average, weighted by the new symbol counts,
+ *   provided that is within HUFF_APP_BOOKCACHE_NEAR_MILLIBITS per symbol and
+ *   that it has a code for every symbol present. Only on a miss are a code
+ *   book and decode table built, into the least recently used entry of a
+ *   fixed pool.
+ *
+ *   The cache is only used from the app main task.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_bookcache.h"
+#include "huff_app_utils.h"
+
+/* Quantized value of the rarest symbols; absent symbols quantize to 0 */
+#define HUFF_APP_BOOKCACHE_QUANT_MAX 24
+
+typedef struct
+{
+    HUFF_APP_BookCacheEntry_t Entry[HUFF_APP_BOOKCACHE_ENTRIES];
+    uint32                    Clock;
+
+    uint32 Lookups;
+    uint32 Hits;     /* Exact matches of the quantized histogram */
+    uint32 NearHits; /* Close enough matches */
+    uint32 Builds;
+    uint64 BuildMicros; /* Time spent building on misses */
+} HUFF_APP_BookCacheData_t;
+
+static HUFF_APP_BookCacheData_t HUFF_APP_BookCacheData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Quantize a histogram to rounded -log2(probability) per symbol, and hash it */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_BookCacheQuantize(const uint32 *Hist, uint64 Total, uint8 *Quant)
+{
+    uint64 Scaled;
+    uint32 Hash = 2166136261u;
+    uint32 Q;
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Q = 0;
+        if (Hist[i] != 0)
+        {
+            /* Halve the total until it drops to the count: about log2(Total / Count) steps */
+            Scaled = Total;
+            Q      = 1;
+            while (Scaled > Hist[i] + (Hist[i] >> 1) && Q < HUFF_APP_BOOKCACHE_QUANT_MAX)
+            {
+                Scaled >>= 1;
+                Q++;
+            }
+        }
+
+        Quant[i] = Q;
+        Hash     = (Hash ^ Q) * 16777619u;
+    }
+
+    return Hash;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Mean quantized code length difference in millibits per symbol, or          */
+/* UINT32_MAX when the cached book lacks a code for a symbol of Hist          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_BookCacheDistance(const HUFF_APP_BookCacheEntry_t *Entry, const uint32 *Hist,
+                                         const uint8 *Quant, uint64 Total)
+{
+    uint64 Weighted = 0;
+    uint32 Diff;
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Quant[i] != 0 && Entry->Book.Lengths[i] == 0)
+        {
+            return UINT32_MAX;
+        }
+        Diff = (Quant[i] > Entry->Quant[i]) ? (Quant[i] - Entry->Quant[i]) : (Entry->Quant[i] - Quant[i]);
+        Weighted += (uint64)Hist[i] * Diff;
+    }
+
+    return (Total != 0) ? (uint32)((Weighted * 1000) / Total) : 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Code book and decode table for a histogram, from the cache when possible   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_BookCacheEntry_t *HUFF_APP_BookCacheGet(const uint32 *Hist)
+{
+    HUFF_APP_BookCacheEntry_t *Entry;
+    HUFF_APP_BookCacheEntry_t *Near   = NULL;
+    HUFF_APP_BookCacheEntry_t *Victim = NULL;
+    uint8                      Quant[HUFF_APP_CODEC_SYMBOLS];
+    uint8                      Lengths[HUFF_APP_CODEC_SYMBOLS];
+    uint32                     NearDistance = HUFF_APP_BOOKCACHE_NEAR_MILLIBITS + 1;
+    uint64                     Total        = 0;
+    uint32                     Distance;
+    uint32                     Hash;
+    int64                      StartMicros;
+    uint32                     i;
+
+    HUFF_APP_BookCacheData.Lookups++;
+    HUFF_APP_BookCacheData.Clock++;
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Total += Hist[i];
+    }
+
+    Hash = HUFF_APP_BookCacheQuantize(Hist, Total, Quant);
+
+    for (i = 0; i < HUFF_APP_BOOKCACHE_ENTRIES; i++)
+    {
+        Entry = &HUFF_APP_BookCacheData.Entry[i];
+        if (!Entry->Valid)
+        {
+            Victim = Entry;
+            continue;
+        }
+
+        if (Entry->Hash == Hash && memcmp(Entry->Quant, Quant, sizeof(Quant)) == 0)
+        {
+            HUFF_APP_BookCacheData.Hits++;
+            Entry->LastUse = HUFF_APP_BookCacheData.Clock;
+            return Entry;
+        }
+
+        Distance = HUFF_APP_BookCacheDistance(Entry, Hist, Quant, Total);
+        if (Distance < NearDistance)
+        {
+            Near         = Entry;
+            NearDistance = Distance;
+        }
+
+        if (Victim == NULL || (Victim->Valid && Entry->LastUse < Victim->LastUse))
+        {
+            Victim = Entry;
+        }
+    }
+
+    if (Near != NULL)
+    {
+        HUFF_APP_BookCacheData.NearHits++;
+        Near->LastUse = HUFF_APP_BookCacheData.Clock;
+        return Near;
+    }
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    Victim->Valid = false;
+    HUFF_APP_CodecBuildLengths(Hist, Lengths);
+    if (HUFF_APP_CodecBuildCodeBook(Lengths, &Victim->Book) != CFE_SUCCESS)
+    {
+        return NULL;
+    }
+    HUFF_APP_CodecBuildDecodeTable(&Victim->Book, &Victim->Table);
+
+    memcpy(Victim->Quant, Quant, sizeof(Victim->Quant));
+    Victim->Hash    = Hash;
+    Victim->LastUse = HUFF_APP_BookCacheData.Clock;
+    Victim->Valid   = true;
+
+    HUFF_APP_BookCacheData.Builds++;
+    HUFF_APP_BookCacheData.BuildMicros += HUFF_APP_GetTimeMicros() - StartMicros;
+
+    return Victim;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Copy the cache counters into housekeeping                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_BookCacheGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    const HUFF_APP_BookCacheData_t *Cache = &HUFF_APP_BookCacheData;
+    uint32                          Reused = Cache->Hits + Cache->NearHits;
+
+    Hk->BookCacheLookups  = Cache->Lookups;
+    Hk->BookCacheHits     = Cache->Hits;
+    Hk->BookCacheNearHits = Cache->NearHits;
+    Hk->BookCacheHitRatePermille =
+        (Cache->Lookups != 0) ? (uint16)(((uint64)Reused * 1000) / Cache->Lookups) : 0;
+
+    /* Each reuse saved one build, at the average cost of the builds done */
+    Hk->BookCacheSavedMicros = (Cache->Builds != 0) ? (uint32)((Cache->BuildMicros * Reused) / Cache->Builds) : 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Clear the cache counters, keeping the cached books                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_BookCacheResetStats(void)
+{
+    HUFF_APP_BookCacheData.Lookups     = 0;
+    HUFF_APP_BookCacheData.Hits        = 0;
+    HUFF_APP_BookCacheData.NearHits    = 0;
+    HUFF_APP_BookCacheData.Builds      = 0;
+    HUFF_APP_BookCacheData.BuildMicros = 0;
+}
@@ -0,0 +1,50 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App code book cache
+ */
+
+#ifndef HUFF_APP_BOOKCACHE_H
+#define HUFF_APP_BOOKCACHE_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_codec.h"
+
+/*
+** Built code book and decode table, with the statistics they were built for
+*/
+typedef struct
+{
+    bool                   Valid;
+    uint32                 Hash;    /* Hash of Quant */
+    uint32                 LastUse; /* Lookup clock value of the last hit, for LRU eviction */
+    uint8                  Quant[HUFF_APP_CODEC_SYMBOLS];
+    HUFF_APP_CodeBook_t    Book;
+    HUFF_APP_DecodeTable_t Table;
+} HUFF_APP_BookCacheEntry_t;
+
+const HUFF_APP_BookCacheEntry_t *HUFF_APP_BookCacheGet(const uint32 *Hist);
+void                             HUFF_APP_BookCacheGetStats(HUFF_APP_HkTlm_Payload_t *Hk);
+void                             HUFF_APP_BookCacheResetStats(void);
+
+#endif /* HUFF_APP_BOOKCACHE_H */
@@ -24,6 +24,8 @@
 /*
 ** Include Files:
 */
+#include <stdio.h>
+
 #include "huff_app.h"
 #include "huff_app_cmds.h"
 #include "huff_app_msgids.h"
@@ -32,9 +34,25 @@
 #include "huff_app_tbl.h"
 #include "huff_app_utils.h"
 #include "huff_app_msg.h"
-
-/* The bench_lib module provides the benchmark functions prototypes */
-#include "bench_lib.h"
+#include "huff_app_ab.h"
+#include "huff_app_adapt.h"
+#include "huff_app_bench.h"
+#include "huff_app_dispstat.h"
+#include "huff_app_duty.h"
+#include "huff_app_baseline.h"
+#include "huff_app_interf.h"
+#include "huff_app_corpus.h"
+#include "huff_app_gen.h"
+#include "huff_app_exec.h"
+#include "huff_app_pardec.h"
+#include "huff_app_perflog.h"
+#include "huff_app_replay.h"
+#include "huff_app_runstat.h"
+#include "huff_app_sweep.h"
+#include "huff_app_service.h"
+#include "huff_app_tlmc.h"
+#include "huff_app_bookcache.h"
+#include "huff_app_trace.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
@@ -46,33 +64,106 @@
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 CFE_Status_t HUFF_APP_SendHkCmd(const HUFF_APP_SendHkCmd_t *Msg)
 {
-    //int i;
+    HUFF_APP_HkTlm_Payload_t *Hk = &HUFF_APP_Data.HkTlm.Payload;
+    int64                     NowMicros;
+    int64                     IntervalMicros;
+    uint64                    Rate;
+    int                       i;
 
     /*
     ** Get command execution counters...
     */
-    HUFF_APP_Data.HkTlm.Payload.CommandErrorCounter = HUFF_APP_Data.ErrCounter;
-    HUFF_APP_Data.HkTlm.Payload.CommandCounter      = HUFF_APP_Data.CmdCounter;
+    HUFF_APP_Data.HkTlm.Payload.CommandErrorCounter = (uint8)HUFF_APP_Data.ErrCounter;
+    HUFF_APP_Data.HkTlm.Payload.CommandCounter      = (uint8)HUFF_APP_Data.CmdCounter;
+    HUFF_APP_Data.HkTlm.Payload.CommandErrorCount   = HUFF_APP_Data.ErrCounter;
+    HUFF_APP_Data.HkTlm.Payload.CommandCount        = HUFF_APP_Data.CmdCounter;
+    HUFF_APP_Data.HkTlm.Payload.DroppedMsgCount     = HUFF_APP_Data.DroppedMsgCount;
+    HUFF_APP_Data.HkTlm.Payload.InputMode           = HUFF_APP_Data.InputMode;
+    HUFF_APP_Data.HkTlm.Payload.IterationCount      = HUFF_APP_Data.IterationCount;
+    HUFF_APP_Data.HkTlm.Payload.MinSampleMicros     = HUFF_APP_Data.MinSampleMicros;
+    HUFF_APP_Data.HkTlm.Payload.FlaggedSampleCount  = HUFF_APP_Data.FlaggedSampleCount;
+    HUFF_APP_Data.HkTlm.Payload.RejectedSampleCount = HUFF_APP_Data.RejectedSampleCount;
+
+    HUFF_APP_ServiceGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_TlmcGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_BookCacheGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_ParDecGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_ExecGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_DutyGetStats(&HUFF_APP_Data.HkTlm.Payload);
+    HUFF_APP_RunStatGetStats(&HUFF_APP_Data.HkTlm.Payload);
+
+    /*
+    ** Decode throughput of the benchmark commands since the previous HK packet
+    */
+    NowMicros      = HUFF_APP_GetTimeMicros();
+    IntervalMicros = NowMicros - HUFF_APP_Data.HkLastMicros;
+
+    Hk->DecodeKiloBytesPerSec = 0;
+    Hk->DecodeSymbolsPerSec   = 0;
+
+    /* The executor resets the totals some time after RESET_COUNTERS: restart from zero */
+    if (Hk->DecodedBytes < HUFF_APP_Data.HkLastDecodedBytes ||
+        Hk->DecodedSymbols < HUFF_APP_Data.HkLastDecodedSymbols)
+    {
+        HUFF_APP_Data.HkLastDecodedBytes   = 0;
+        HUFF_APP_Data.HkLastDecodedSymbols = 0;
+    }
+    if (HUFF_APP_Data.HkLastMicros != 0 && IntervalMicros > 0)
+    {
+        Rate = ((Hk->DecodedBytes - HUFF_APP_Data.HkLastDecodedBytes) * 1000) / (uint64)IntervalMicros;
+        Hk->DecodeKiloBytesPerSec = (Rate > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)Rate;
+
+        Rate = ((Hk->DecodedSymbols - HUFF_APP_Data.HkLastDecodedSymbols) * 1000000) / (uint64)IntervalMicros;
+        Hk->DecodeSymbolsPerSec = (Rate > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)Rate;
+    }
+
+    HUFF_APP_Data.HkLastMicros         = NowMicros;
+    HUFF_APP_Data.HkLastDecodedBytes   = Hk->DecodedBytes;
+    HUFF_APP_Data.HkLastDecodedSymbols = Hk->DecodedSymbols;
 
     /*
     ** Send housekeeping telemetry packet...
     */
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_TRANSMIT);
     CFE_SB_TimeStampMsg(CFE_MSG_PTR(HUFF_APP_Data.HkTlm.TelemetryHeader));
     CFE_SB_TransmitMsg(CFE_MSG_PTR(HUFF_APP_Data.HkTlm.TelemetryHeader), true);
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_TRANSMIT);
 
-    // /*
-    // ** Manage any pending table loads, validations, etc.
-    // */
-    // for (i = 0; i < HUFF_APP_NUMBER_OF_TABLES; i++)
-    // {
-    //     CFE_TBL_Manage(HUFF_APP_Data.TblHandles[i]);
-    // }
+    /*
+    ** Manage any pending table loads, validations, etc.
+    */
+    for (i = 0; i < HUFF_APP_NUMBER_OF_TABLES; i++)
+    {
+        if (CFE_TBL_Manage(HUFF_APP_Data.TblHandles[i]) == CFE_TBL_INFO_UPDATED)
+        {
+            HUFF_APP_Data.TblBooksPending = HUFF_APP_TBL_ALL_BOOKS;
+        }
+    }
+
+    /* Code books changed or still in use last time: rebuild their decode tables here, outside the decode path */
+    if (HUFF_APP_Data.TblBooksPending != 0)
+    {
+        HUFF_APP_TblApplyBooks();
+    }
+
+    /* Baselines recorded by BATCH commands become visible to table dumps here */
+    HUFF_APP_BaselineManage();
 
     return CFE_SUCCESS;
 }
 
-#define REPORT_MAX_LENGTH 128
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Compresses the telemetry queued since the last wakeup              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_TlmcWakeupCmd(const HUFF_APP_TlmcWakeupCmd_t *Msg)
+{
+    HUFF_APP_TlmcWakeup();
 
+    return CFE_SUCCESS;
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
@@ -82,109 +173,546 @@ CFE_Status_t HUFF_APP_SendHkCmd(const HUFF_APP_SendHkCmd_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 CFE_Status_t HUFF_APP_RunCmd(const HUFF_APP_RunCmd_t *Msg)
 {
-    int32              status;
-    uint8_t            table;
-    uint16_t           check_e;
-    uint16_t           check_d;
-    OS_time_t          LocalTime;
-    int64              RefrTimeMillis;
-    int64              NowTimeMillis;
-
-//OS_printf("%s %d\n", __func__, __LINE__);
+    HUFF_APP_Sample_t Sample;
+    HUFF_APP_Report_t Report;
+    CFE_Status_t      status;
+    uint32            CyclesPerIteration = 0;
+    uint32            i;
+
+    if (HUFF_APP_Data.InputMode == HUFF_APP_InputMode_CORPUS)
+    {
+        status = HUFF_APP_CorpusRun();
+        HUFF_APP_RunStatDone(status);
+        return status;
+    }
+    if (HUFF_APP_Data.InputMode == HUFF_APP_InputMode_GEN)
+    {
+        status = HUFF_APP_GenRun();
+        HUFF_APP_RunStatDone(status);
+        return status;
+    }
 
-    uint8_t print_buffer[16];
-    char task_report_buffer[REPORT_MAX_LENGTH];
-    char task_report_buffer_checksum[3];
+    HUFF_APP_BenchGuardedSample(HUFF_APP_CurrentSeed(), HUFF_APP_Data.IterationCount, &Sample);
+    HUFF_APP_ReplayLog(&Sample);
+    HUFF_APP_RunStatDone(Sample.Status);
 
+    if (Sample.Status != CFE_SUCCESS) {
+        CFE_ES_WriteToSysLog("HUFF App: Fail to run benchmark: 0x%08lx", (unsigned long)Sample.Status);
+    }
 
-    memset(&LocalTime, 0, sizeof(LocalTime));
-    CFE_PSP_GetTime(&LocalTime);
-    RefrTimeMillis = OS_TimeGetTotalMilliseconds(LocalTime);
+    HUFF_APP_ReportInit(&Report, "$HUNU");
 
-    /* Invoke the benchmark function provided by Benchmark library */
-    status = BENCH_LIB_HuffBenchTask(
-        BENCH_LIB_u16Maj(HUFF_APP_Data.RandomizingSeed_1, HUFF_APP_Data.RandomizingSeed_2, HUFF_APP_Data.RandomizingSeed_3),
-        &table, &check_e, &check_d);
+    // Current time
+    HUFF_APP_ReportAddU32(&Report, Sample.StartMicros / 1000);
+    // Compiler debug flags and machine caches settings
+    HUFF_APP_ReportAddBuildId(&Report);
+
+    // Test case results, time of one benchmark run
+    HUFF_APP_ReportAddU32(&Report, (Sample.DurationMicros / Sample.Iterations) / 1000);
+    HUFF_APP_ReportAddHexU32(&Report, Sample.Status);
+    HUFF_APP_ReportAddHexU16(&Report, Sample.Seed);
+    HUFF_APP_ReportAddHexU8(&Report, Sample.FirstTable);
+    HUFF_APP_ReportAddHexU16(&Report, Sample.FirstCheckE);
+    HUFF_APP_ReportAddHexU16(&Report, Sample.FirstCheckD);
+
+    /* One step of the seed chain per run, whatever the iterations timed in the sample */
+    HUFF_APP_Data.RandomizingSeed_1 = Sample.FirstCheckD;
+    HUFF_APP_Data.RandomizingSeed_2 = Sample.FirstCheckD;
+    HUFF_APP_Data.RandomizingSeed_3 = Sample.FirstCheckD;
 
-    memset(&LocalTime, 0, sizeof(LocalTime));
-    CFE_PSP_GetTime(&LocalTime);
-    NowTimeMillis = OS_TimeGetTotalMilliseconds(LocalTime);
+    /*
+    ** Send result telemetry packet...
+    */
+    HUFF_APP_ReportSend(&Report);
 
-    if (status != CFE_SUCCESS) {
-        CFE_ES_WriteToSysLog("HUFF App: Fail to run benchmark: 0x%08lx", (unsigned long)status);
+    /*
+    ** Timed sample of the same runs: measurement granularity, CPU frequency
+    ** stability, every field always present, zero when its guard is off, and
+    ** the checks of the last chained invocation
+    */
+    if (HUFF_APP_Data.GuardMode != HUFF_APP_GuardMode_OFF && HUFF_APP_Data.GuardNormalize)
+    {
+        CyclesPerIteration = HUFF_APP_SampleCyclesPerIteration(&Sample);
     }
 
-    strncpy(task_report_buffer, "$HUNU,", REPORT_MAX_LENGTH);
-
-    // Current time
-    BENCH_LIB_vPrintU32(print_buffer, RefrTimeMillis);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    // Compiler debug flags
-    BENCH_LIB_vPrintHexU8(print_buffer, BENCH_LIB_u8BuildFlags());
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, "-", REPORT_MAX_LENGTH);
-    // Machine caches settings
-    BENCH_LIB_vPrintHexU8(print_buffer, BENCH_LIB_u8GetCacheSettings());
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    // Test case results
-    BENCH_LIB_vPrintU32(print_buffer, NowTimeMillis-RefrTimeMillis);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_vPrintHexU32(print_buffer, status);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_vPrintHexU16(print_buffer, BENCH_LIB_u16Maj(HUFF_APP_Data.RandomizingSeed_1, HUFF_APP_Data.RandomizingSeed_2, HUFF_APP_Data.RandomizingSeed_3));
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_vPrintHexU8(print_buffer, table);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_vPrintHexU16(print_buffer, check_e);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, ",", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_vPrintHexU16(print_buffer, check_d);
-    strncat(task_report_buffer, (char*)print_buffer, REPORT_MAX_LENGTH);
-    strncat(task_report_buffer, "*", REPORT_MAX_LENGTH);
-
-    BENCH_LIB_pcGenerateChecksum(task_report_buffer, task_report_buffer_checksum);
-    task_report_buffer_checksum[2] = 0;
-    strncat(task_report_buffer, task_report_buffer_checksum, REPORT_MAX_LENGTH);
-    
-    task_report_buffer[REPORT_MAX_LENGTH-1] = '\0';
-
-    HUFF_APP_Data.RandomizingSeed_1 = check_d;
-    HUFF_APP_Data.RandomizingSeed_2 = check_d;
-    HUFF_APP_Data.RandomizingSeed_3 = check_d;
+    HUFF_APP_ReportInit(&Report, "$HUSM");
+    HUFF_APP_ReportAddU32(&Report, Sample.StartMicros / 1000);
+    HUFF_APP_ReportAddU32(&Report, Sample.Iterations);
+    HUFF_APP_ReportAddU32(&Report, Sample.DurationMicros);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_SampleNanosPerIteration(&Sample));
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.GuardMode);
+    HUFF_APP_ReportAddU32(&Report, Sample.DriftPermille);
+    HUFF_APP_ReportAddU32(&Report, Sample.Unstable);
+    HUFF_APP_ReportAddU32(&Report, CyclesPerIteration);
+    HUFF_APP_ReportAddHexU8(&Report, Sample.Table);
+    HUFF_APP_ReportAddHexU16(&Report, Sample.CheckE);
+    HUFF_APP_ReportAddHexU16(&Report, Sample.CheckD);
+    HUFF_APP_ReportSend(&Report);
 
     /*
-    ** Send result telemetry packet...
+    ** Performance counter increments over the same sample, when available
     */
-    status = CFE_SB_MessageStringSet(
-        HUFF_APP_Data.ResultTlm.Payload.ResultStr,
-        task_report_buffer,
-        sizeof(HUFF_APP_Data.ResultTlm.Payload.ResultStr),
-        sizeof(task_report_buffer)
-    );
-    if (status == CFE_SB_BAD_ARGUMENT) {
-        CFE_ES_WriteToSysLog("HUFF App: Fail to post result: 0x%08lx", (unsigned long)status);
+    if (HUFF_APP_PerfCtrAvailable())
+    {
+        HUFF_APP_ReportInit(&Report, "$HUPC");
+        HUFF_APP_ReportAddU32(&Report, Sample.StartMicros / 1000);
+        HUFF_APP_ReportAddHexU8(&Report, Sample.Counters.OpenMask);
+        HUFF_APP_ReportAddHexU8(&Report, Sample.Counters.SoftwareMask);
+        for (i = 0; i < HUFF_APP_PERFCTR_COUNT; i++)
+        {
+            HUFF_APP_ReportAddHexU64(&Report, Sample.Counters.Value[i]);
+        }
+        HUFF_APP_ReportSend(&Report);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Runs the benchmark without and then with background interference   */
+/*         on the same seed chain, and reports both timings side by side      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_ContendCmd(const HUFF_APP_ContendCmd_t *Msg)
+{
+    const HUFF_APP_Contend_Payload_t *CmdPtr = &Msg->Payload;
+    HUFF_APP_Sample_t                 Sample;
+    HUFF_APP_Report_t                 Report;
+    int64                             PhaseMicros[2];
+    uint32                            Failures;
+    uint32                            Phase;
+    uint32                            Run;
+    uint32                            SlowdownPermille;
+    uint16                            Seed;
+    CFE_Status_t                      status;
+
+    if (CmdPtr->Kind == HUFF_APP_InterfKind_NONE || CmdPtr->Kind > HUFF_APP_InterfKind_SPIN ||
+        CmdPtr->NumTasks == 0 || CmdPtr->NumTasks > HUFF_APP_INTERF_MAX_TASKS || CmdPtr->NumRuns == 0 ||
+        CmdPtr->NumRuns > HUFF_APP_CONTEND_MAX_RUNS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_CONTEND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid contend command: Kind = %u, Tasks = %u, Runs = %u",
+                          (unsigned int)CmdPtr->Kind, (unsigned int)CmdPtr->NumTasks,
+                          (unsigned int)CmdPtr->NumRuns);
+        HUFF_APP_Data.ErrCounter++;
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    Failures = 0;
+
+    /* Phase 0 runs isolated, phase 1 under interference, both on the same seeds */
+    for (Phase = 0; Phase < 2; Phase++)
+    {
+        if (Phase == 1)
+        {
+            status = HUFF_APP_InterfStart(CmdPtr->Kind, CmdPtr->NumTasks);
+            if (status != CFE_SUCCESS)
+            {
+                CFE_EVS_SendEvent(HUFF_APP_CONTEND_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "HUFF: Failed to start interference tasks, RC = 0x%08lX", (unsigned long)status);
+                HUFF_APP_InterfStop();
+                HUFF_APP_Data.ErrCounter++;
+                return status;
+            }
+        }
+
+        PhaseMicros[Phase] = 0;
+        Seed               = HUFF_APP_CurrentSeed();
+
+        for (Run = 0; Run < CmdPtr->NumRuns; Run++)
+        {
+            if (HUFF_APP_ExecCancelled())
+            {
+                HUFF_APP_InterfStop();
+                HUFF_APP_Data.CmdCounter++;
+                return CFE_SUCCESS;
+            }
+
+            HUFF_APP_BenchSample(Seed, HUFF_APP_Data.IterationCount, &Sample);
+            if (Sample.Status != CFE_SUCCESS)
+            {
+                Failures++;
+            }
+            PhaseMicros[Phase] += Sample.DurationMicros;
+            Seed = Sample.CheckD;
+        }
+    }
+
+    HUFF_APP_InterfStop();
+
+    SlowdownPermille = 0;
+    if (PhaseMicros[0] > 0)
+    {
+        SlowdownPermille = (uint32)((PhaseMicros[1] * 1000) / PhaseMicros[0]);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUIF");
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_GetTimeMicros() / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, CmdPtr->Kind);
+    HUFF_APP_ReportAddU32(&Report, CmdPtr->NumTasks);
+    HUFF_APP_ReportAddU32(&Report, CmdPtr->NumRuns);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.IterationCount);
+    HUFF_APP_ReportAddU32(&Report, PhaseMicros[0] / CmdPtr->NumRuns);
+    HUFF_APP_ReportAddU32(&Report, PhaseMicros[1] / CmdPtr->NumRuns);
+    HUFF_APP_ReportAddU32(&Report, SlowdownPermille);
+    HUFF_APP_ReportAddU32(&Report, Failures);
+    HUFF_APP_ReportSend(&Report);
+
+    CFE_EVS_SendEvent(HUFF_APP_CONTEND_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Contended run: kind %u x%u, %u runs, %ld us -> %ld us per run (%u permille)",
+                      (unsigned int)CmdPtr->Kind, (unsigned int)CmdPtr->NumTasks, (unsigned int)CmdPtr->NumRuns,
+                      (long)(PhaseMicros[0] / CmdPtr->NumRuns), (long)(PhaseMicros[1] / CmdPtr->NumRuns),
+                      (unsigned int)SlowdownPermille);
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Recalibrates the number of benchmark invocations per timed sample  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_CalibrateCmd(const HUFF_APP_CalibrateCmd_t *Msg)
+{
+    HUFF_APP_BenchCalibrate(Msg->Payload.MinSampleMicros);
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Configures the CPU frequency stability guard                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_SetGuardCmd(const HUFF_APP_SetGuardCmd_t *Msg)
+{
+    const HUFF_APP_SetGuard_Payload_t *CmdPtr = &Msg->Payload;
+
+    if (CmdPtr->Mode > HUFF_APP_GuardMode_REJECT)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_GUARD_ERR_EID, CFE_EVS_EventType_ERROR, "HUFF: Invalid guard mode %u",
+                          (unsigned int)CmdPtr->Mode);
+        HUFF_APP_Data.ErrCounter++;
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    HUFF_APP_Data.GuardMode              = CmdPtr->Mode;
+    HUFF_APP_Data.GuardNormalize         = (CmdPtr->Normalize != 0);
+    HUFF_APP_Data.GuardTolerancePermille = CmdPtr->TolerancePermille;
+    if (HUFF_APP_Data.GuardTolerancePermille == 0)
+    {
+        HUFF_APP_Data.GuardTolerancePermille = HUFF_APP_GUARD_DEFAULT_TOLERANCE;
     }
-    HUFF_APP_Data.ResultTlm.Payload.ResultStr[sizeof(HUFF_APP_Data.ResultTlm.Payload.ResultStr)-1] = '\0';
-//OS_printf("%s %u %s\n", __func__, __LINE__, HUFF_APP_Data.ResultTlm.Payload.ResultStr);
-    CFE_SB_TimeStampMsg(CFE_MSG_PTR(HUFF_APP_Data.ResultTlm.TelemetryHeader));
-    CFE_SB_TransmitMsg(CFE_MSG_PTR(HUFF_APP_Data.ResultTlm.TelemetryHeader), true /* IsOrigination: fix sequence, timestamp etc. */);
+
+    CFE_EVS_SendEvent(HUFF_APP_GUARD_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Stability guard mode %u, tolerance %u permille, loop %ld us",
+                      (unsigned int)HUFF_APP_Data.GuardMode, (unsigned int)HUFF_APP_Data.GuardTolerancePermille,
+                      (long)HUFF_APP_GuardLoopMicros());
+
+    HUFF_APP_Data.CmdCounter++;
 
     return CFE_SUCCESS;
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Loads a corpus file to be decoded by the scheduled runs, or        */
+/*         unloads it when the file name is empty                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_LoadCorpusCmd(const HUFF_APP_LoadCorpusCmd_t *Msg)
+{
+    char         FileName[HUFF_APP_FILENAME_LEN];
+    CFE_Status_t status;
+
+    CFE_SB_MessageStringGet(FileName, Msg->Payload.FileName, NULL, sizeof(FileName),
+                            sizeof(Msg->Payload.FileName));
+
+    if (FileName[0] == '\0')
+    {
+        HUFF_APP_CorpusUnload();
+        CFE_EVS_SendEvent(HUFF_APP_CORPUS_INF_EID, CFE_EVS_EventType_INFORMATION, "HUFF: Corpus unloaded");
+        HUFF_APP_Data.CmdCounter++;
+        return CFE_SUCCESS;
+    }
+
+    status = HUFF_APP_CorpusLoad(FileName);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Generates a synthetic input to be decoded by the scheduled runs    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_GenerateCmd(const HUFF_APP_GenerateCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_GenLoad(&Msg->Payload);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Profiles the decoder over a geometric series of input sizes        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_SweepCmd(const HUFF_APP_SweepCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_SweepRun(Msg->Payload.MinBytes, Msg->Payload.MaxBytes);
+    if (status == CFE_STATUS_INCORRECT_STATE || status == CFE_STATUS_RANGE_ERROR)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Capture a CFE_ES performance log of a batch of benchmark runs              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_PerfCaptureCmd(const HUFF_APP_PerfCaptureCmd_t *Msg)
+{
+    char         FileName[HUFF_APP_FILENAME_LEN];
+    uint32       Run;
+    uint32       Failures = 0;
+    CFE_Status_t status;
+
+    if (Msg->Payload.NumRuns == 0 || Msg->Payload.NumRuns > HUFF_APP_PERFCAP_MAX_RUNS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PERFCAP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid perf capture: Runs = %lu", (unsigned long)Msg->Payload.NumRuns);
+        HUFF_APP_Data.ErrCounter++;
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    CFE_SB_MessageStringGet(FileName, Msg->Payload.FileName, NULL, sizeof(FileName),
+                            sizeof(Msg->Payload.FileName));
+
+    status = HUFF_APP_PerfLogStart();
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PERFCAP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to start the perf log capture, RC = 0x%08lX", (unsigned long)status);
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    for (Run = 0; Run < Msg->Payload.NumRuns && !HUFF_APP_ExecCancelled(); Run++)
+    {
+        CFE_ES_PerfLogEntry(HUFF_APP_RUN_PERF_ID);
+        status = HUFF_APP_RunCmd(NULL);
+        CFE_ES_PerfLogExit(HUFF_APP_RUN_PERF_ID);
+
+        if (status != CFE_SUCCESS)
+        {
+            Failures++;
+        }
+    }
+
+    status = HUFF_APP_PerfLogStop(FileName);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PERFCAP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to stop the perf log capture, RC = 0x%08lX", (unsigned long)status);
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_PERFCAP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Perf log of %lu runs (%lu failed) written to %s", (unsigned long)Run,
+                      (unsigned long)Failures, (FileName[0] != '\0') ? FileName : "the ES default file");
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Run a batch of samples and record it as the baseline of this build, or     */
+/* check it against that baseline for a regression                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_BatchCmd(const HUFF_APP_BatchCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    if (Msg->Payload.NumRuns == 0 || Msg->Payload.NumRuns > HUFF_APP_BATCH_MAX_RUNS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_BASE_ERR_EID, CFE_EVS_EventType_ERROR, "HUFF: Invalid batch: Runs = %u",
+                          (unsigned int)Msg->Payload.NumRuns);
+        HUFF_APP_Data.ErrCounter++;
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    status = HUFF_APP_BaselineRun(Msg->Payload.NumRuns, Msg->Payload.Record != 0);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Re-run logged seeds of the benchmark chain, or send the replay log         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ReplayCmd(const HUFF_APP_ReplayCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_ReplayRun(Msg->Payload.Seed, Msg->Payload.Count, Msg->Payload.Repeats);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Compare two decode kernels with interleaved ABBA runs                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_AbCompareCmd(const HUFF_APP_AbCompareCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_AbRun(&Msg->Payload);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Sample the benchmark until the commanded precision is reached              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_AdaptiveRunCmd(const HUFF_APP_AdaptiveRunCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_AdaptRun(&Msg->Payload);
+    if (status != CFE_SUCCESS)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Write the phase trace rings to a file                                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_TraceDumpCmd(const HUFF_APP_TraceDumpCmd_t *Msg)
+{
+    char         FileName[HUFF_APP_FILENAME_LEN];
+    CFE_Status_t status;
+
+    CFE_SB_MessageStringGet(FileName, Msg->Payload.FileName, NULL, sizeof(FileName),
+                            sizeof(Msg->Payload.FileName));
+
+    if (FileName[0] == '\0')
+    {
+        snprintf(FileName, sizeof(FileName), "%s%s", HUFF_APP_TRACE_DEFAULT_FILE,
+                 (Msg->Payload.Format == HUFF_APP_TraceFormat_BINARY) ? ".bin" : ".json");
+    }
+
+    status = HUFF_APP_TraceDump(FileName, Msg->Payload.Format);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_TRACE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Trace dump to %s failed, format %u, RC = 0x%08lX", FileName,
+                          (unsigned int)Msg->Payload.Format, (unsigned long)status);
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_TRACE_INF_EID, CFE_EVS_EventType_INFORMATION, "HUFF: Trace written to %s",
+                      FileName);
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode the current input in parallel from its block index                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ParDecodeCmd(const HUFF_APP_ParDecodeCmd_t *Msg)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_ParDecRun(Msg->Payload.MaxWorkers, Msg->Payload.Sched);
+    if (status == CFE_STATUS_INCORRECT_STATE || status == CFE_STATUS_RANGE_ERROR)
+    {
+        HUFF_APP_Data.ErrCounter++;
+        return status;
+    }
+
+    HUFF_APP_Data.CmdCounter++;
+
+    return status;
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
@@ -201,6 +729,47 @@ CFE_Status_t HUFF_APP_NoopCmd(const HUFF_APP_NoopCmd_t *Msg)
     return CFE_SUCCESS;
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Drops the queued benchmark commands and stops the running one at   */
+/*         its next check                                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t HUFF_APP_CancelCmd(const HUFF_APP_CancelCmd_t *Msg)
+{
+    uint32 Queued;
+    bool   WasRunning;
+
+    Queued = HUFF_APP_ExecCancel(&WasRunning);
+
+    HUFF_APP_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(HUFF_APP_EXEC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Cancelled %lu queued benchmark commands%s", (unsigned long)Queued,
+                      WasRunning ? " and the running one" : "");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Send the message counts and handling times of every dispatch slot          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_DispatchStatsCmd(const HUFF_APP_DispatchStatsCmd_t *Msg)
+{
+    uint32 Sent;
+
+    Sent = HUFF_APP_DispStatDump();
+
+    CFE_EVS_SendEvent(HUFF_APP_DISP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Dispatch statistics of %lu slots sent", (unsigned long)Sent);
+    HUFF_APP_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /*  Purpose:                                                                  */
@@ -210,10 +779,51 @@ CFE_Status_t HUFF_APP_NoopCmd(const HUFF_APP_NoopCmd_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 CFE_Status_t HUFF_APP_ResetCountersCmd(const HUFF_APP_ResetCountersCmd_t *Msg)
 {
-    HUFF_APP_Data.CmdCounter = 0;
-    HUFF_APP_Data.ErrCounter = 0;
+    CFE_Status_t status;
+
+    HUFF_APP_Data.CmdCounter      = 0;
+    HUFF_APP_Data.ErrCounter      = 0;
+    HUFF_APP_Data.DroppedMsgCount = 0;
+
+    HUFF_APP_ServiceResetStats();
+    HUFF_APP_TlmcResetStats();
+    HUFF_APP_BookCacheResetStats();
+    HUFF_APP_ExecResetStats();
+    HUFF_APP_DutyResetStats();
+    HUFF_APP_DispStatResetStats();
+
+    /*
+    ** The counters written by the executor task are reset by the executor,
+    ** between two benchmark commands
+    */
+    status = HUFF_APP_ExecSubmit((const CFE_SB_Buffer_t *)Msg);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_EXEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Benchmark counters reset not queued, RC = 0x%08lX", (unsigned long)status);
+    }
 
     CFE_EVS_SendEvent(HUFF_APP_RESET_INF_EID, CFE_EVS_EventType_INFORMATION, "HUFF: RESET command");
 
     return CFE_SUCCESS;
 }
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Second half of RESET_COUNTERS, run by the executor task: the counters it   */
+/* and the decode workers write                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ResetJobCountersCmd(const HUFF_APP_ResetCountersCmd_t *Msg)
+{
+    HUFF_APP_Data.FlaggedSampleCount  = 0;
+    HUFF_APP_Data.RejectedSampleCount = 0;
+
+    HUFF_APP_ParDecResetStats();
+    HUFF_APP_ExecResetJobStats();
+    HUFF_APP_DutyResetJobStats();
+    HUFF_APP_RunStatResetStats();
+    HUFF_APP_DispStatResetJobStats();
+
+    return CFE_SUCCESS;
+}
@@ -32,7 +32,24 @@
 
 CFE_Status_t HUFF_APP_SendHkCmd(const HUFF_APP_SendHkCmd_t *Msg);
 CFE_Status_t HUFF_APP_RunCmd(const HUFF_APP_RunCmd_t *Msg);
+CFE_Status_t HUFF_APP_TlmcWakeupCmd(const HUFF_APP_TlmcWakeupCmd_t *Msg);
+CFE_Status_t HUFF_APP_ContendCmd(const HUFF_APP_ContendCmd_t *Msg);
+CFE_Status_t HUFF_APP_CalibrateCmd(const HUFF_APP_CalibrateCmd_t *Msg);
+CFE_Status_t HUFF_APP_SetGuardCmd(const HUFF_APP_SetGuardCmd_t *Msg);
+CFE_Status_t HUFF_APP_LoadCorpusCmd(const HUFF_APP_LoadCorpusCmd_t *Msg);
+CFE_Status_t HUFF_APP_GenerateCmd(const HUFF_APP_GenerateCmd_t *Msg);
+CFE_Status_t HUFF_APP_SweepCmd(const HUFF_APP_SweepCmd_t *Msg);
+CFE_Status_t HUFF_APP_ParDecodeCmd(const HUFF_APP_ParDecodeCmd_t *Msg);
+CFE_Status_t HUFF_APP_TraceDumpCmd(const HUFF_APP_TraceDumpCmd_t *Msg);
+CFE_Status_t HUFF_APP_PerfCaptureCmd(const HUFF_APP_PerfCaptureCmd_t *Msg);
+CFE_Status_t HUFF_APP_BatchCmd(const HUFF_APP_BatchCmd_t *Msg);
+CFE_Status_t HUFF_APP_ReplayCmd(const HUFF_APP_ReplayCmd_t *Msg);
+CFE_Status_t HUFF_APP_AbCompareCmd(const HUFF_APP_AbCompareCmd_t *Msg);
+CFE_Status_t HUFF_APP_AdaptiveRunCmd(const HUFF_APP_AdaptiveRunCmd_t *Msg);
+CFE_Status_t HUFF_APP_DispatchStatsCmd(const HUFF_APP_DispatchStatsCmd_t *Msg);
+CFE_Status_t HUFF_APP_CancelCmd(const HUFF_APP_CancelCmd_t *Msg);
 CFE_Status_t HUFF_APP_ResetCountersCmd(const HUFF_APP_ResetCountersCmd_t *Msg);
+CFE_Status_t HUFF_APP_ResetJobCountersCmd(const HUFF_APP_ResetCountersCmd_t *Msg);
 CFE_Status_t HUFF_APP_NoopCmd(const HUFF_APP_NoopCmd_t *Msg);
 //CFE_Status_t HUFF_APP_DisplayParamCmd(const HUFF_APP_DisplayParamCmd_t *Msg);
 
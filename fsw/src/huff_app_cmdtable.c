@@ -0,0 +1,297 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the HUFF App command table and the dispatch of ground
+ *   commands through it, and the routing of every message by its MID, shared
+ *   by the EDS and the non-EDS builds.
+ *
+ *   The table is indexed by command code, so a command is found with one
+ *   array access; it holds the expected length, the handler and the task
+ *   that runs the command. It is const: the counters of each entry are the
+ *   dispatch statistics slots of its command code. In an EDS build the
+ *   command codes and types come from the EDS generated headers, under the
+ *   same names.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_cmds.h"
+#include "huff_app_dispatch.h"
+#include "huff_app_dispstat.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_msgids.h"
+#include "huff_app_msg.h"
+
+/* Command codes above the statistics slots would share a slot, so the table stops there too */
+#define HUFF_APP_CMD_TABLE_SIZE (HUFF_APP_DISPSTAT_MAX_CC + 1)
+
+typedef enum
+{
+    HUFF_APP_CmdTask_MAIN, /* Run on receipt by the app main task */
+    HUFF_APP_CmdTask_EXEC  /* Queued for the executor task: benchmark commands */
+} HUFF_APP_CmdTask_t;
+
+typedef CFE_Status_t (*HUFF_APP_CmdHandler_t)(const CFE_SB_Buffer_t *SBBufPtr);
+
+typedef struct
+{
+    CFE_MSG_FcnCode_t     CommandCode;
+    size_t                ExpectedLength;
+    HUFF_APP_CmdHandler_t Handler; /* NULL for unused codes */
+    HUFF_APP_CmdTask_t    Task;
+} HUFF_APP_CmdEntry_t;
+
+/*
+** Ground commands, one row each: command code, command type, handler and task
+*/
+/* clang-format off */
+#define HUFF_APP_CMD_ROWS(ROW)                                                                          \
+    ROW(HUFF_APP_NOOP_CC,           HUFF_APP_NoopCmd_t,          HUFF_APP_NoopCmd,          MAIN)       \
+    ROW(HUFF_APP_RESET_COUNTERS_CC, HUFF_APP_ResetCountersCmd_t, HUFF_APP_ResetCountersCmd, MAIN)       \
+    ROW(HUFF_APP_SET_GUARD_CC,      HUFF_APP_SetGuardCmd_t,      HUFF_APP_SetGuardCmd,      MAIN)       \
+    ROW(HUFF_APP_CANCEL_CC,         HUFF_APP_CancelCmd_t,        HUFF_APP_CancelCmd,        MAIN)       \
+    ROW(HUFF_APP_CONTEND_CC,        HUFF_APP_ContendCmd_t,       HUFF_APP_ContendCmd,       EXEC)       \
+    ROW(HUFF_APP_CALIBRATE_CC,      HUFF_APP_CalibrateCmd_t,     HUFF_APP_CalibrateCmd,     EXEC)       \
+    ROW(HUFF_APP_LOAD_CORPUS_CC,    HUFF_APP_LoadCorpusCmd_t,    HUFF_APP_LoadCorpusCmd,    EXEC)       \
+    ROW(HUFF_APP_GENERATE_CC,       HUFF_APP_GenerateCmd_t,      HUFF_APP_GenerateCmd,      EXEC)       \
+    ROW(HUFF_APP_SWEEP_CC,          HUFF_APP_SweepCmd_t,         HUFF_APP_SweepCmd,         EXEC)       \
+    ROW(HUFF_APP_PAR_DECODE_CC,     HUFF_APP_ParDecodeCmd_t,     HUFF_APP_ParDecodeCmd,     EXEC)       \
+    ROW(HUFF_APP_TRACE_DUMP_CC,     HUFF_APP_TraceDumpCmd_t,     HUFF_APP_TraceDumpCmd,     EXEC)       \
+    ROW(HUFF_APP_PERF_CAPTURE_CC,   HUFF_APP_PerfCaptureCmd_t,   HUFF_APP_PerfCaptureCmd,   EXEC)       \
+    ROW(HUFF_APP_BATCH_CC,          HUFF_APP_BatchCmd_t,         HUFF_APP_BatchCmd,         EXEC)       \
+    ROW(HUFF_APP_REPLAY_CC,         HUFF_APP_ReplayCmd_t,        HUFF_APP_ReplayCmd,        EXEC)       \
+    ROW(HUFF_APP_AB_COMPARE_CC,     HUFF_APP_AbCompareCmd_t,     HUFF_APP_AbCompareCmd,     EXEC)       \
+    ROW(HUFF_APP_ADAPTIVE_RUN_CC,   HUFF_APP_AdaptiveRunCmd_t,   HUFF_APP_AdaptiveRunCmd,   EXEC)       \
+    ROW(HUFF_APP_DISPATCH_STATS_CC, HUFF_APP_DispatchStatsCmd_t, HUFF_APP_DispatchStatsCmd, EXEC)
+
+/* Handlers take their own command type: the table calls them through these */
+#define HUFF_APP_CMD_ENTRY_FUNC(Code, Type, Handler, Task)              \
+    static CFE_Status_t Handler##Entry(const CFE_SB_Buffer_t *SBBufPtr) \
+    {                                                                   \
+        return Handler((const Type *)SBBufPtr);                         \
+    }
+
+#define HUFF_APP_CMD_ENTRY(Code, Type, Handler, Task) \
+    [Code] = {Code, sizeof(Type), Handler##Entry, HUFF_APP_CmdTask_##Task},
+
+HUFF_APP_CMD_ROWS(HUFF_APP_CMD_ENTRY_FUNC)
+
+/* A row beyond the table size fails to compile */
+static const HUFF_APP_CmdEntry_t HUFF_APP_CmdTable[HUFF_APP_CMD_TABLE_SIZE] = {
+    HUFF_APP_CMD_ROWS(HUFF_APP_CMD_ENTRY)
+};
+/* clang-format on */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Table entry of a command code, NULL when the code is not defined           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static const HUFF_APP_CmdEntry_t *HUFF_APP_CmdLookup(CFE_MSG_FcnCode_t CommandCode)
+{
+    if (CommandCode >= HUFF_APP_CMD_TABLE_SIZE || HUFF_APP_CmdTable[CommandCode].Handler == NULL)
+    {
+        return NULL;
+    }
+
+    return &HUFF_APP_CmdTable[CommandCode];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Verify command packet length                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool HUFF_APP_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+{
+    bool              result       = true;
+    size_t            ActualLength = 0;
+    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t FcnCode      = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
+
+    /*
+    ** Verify the command packet length.
+    */
+    if (ExpectedLength != ActualLength)
+    {
+        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
+
+        CFE_EVS_SendEvent(HUFF_APP_CMD_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u",
+                          (unsigned int)CFE_SB_MsgIdToValue(MsgId), (unsigned int)FcnCode, (unsigned int)ActualLength,
+                          (unsigned int)ExpectedLength);
+
+        result = false;
+
+        HUFF_APP_Data.ErrCounter++;
+        HUFF_APP_Data.DroppedMsgCount++;
+        HUFF_APP_DispStatReject(MsgPtr);
+    }
+
+    return result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Hand a benchmark command over to the executor task                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_SubmitJob(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_Status_t status;
+
+    status = HUFF_APP_ExecSubmit(SBBufPtr);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_EXEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Benchmark command not queued, RC = 0x%08lX", (unsigned long)status);
+        HUFF_APP_Data.ErrCounter++;
+        HUFF_APP_Data.DroppedMsgCount++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* SAMPLE ground commands                                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    const HUFF_APP_CmdEntry_t *Entry;
+    CFE_MSG_FcnCode_t          CommandCode = 0;
+
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
+
+    Entry = HUFF_APP_CmdLookup(CommandCode);
+    if (Entry == NULL)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_CC_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid ground command code: CC = %d",
+                          CommandCode);
+        HUFF_APP_Data.DroppedMsgCount++;
+        return;
+    }
+
+    if (!HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, Entry->ExpectedLength))
+    {
+        return;
+    }
+
+    /*
+    ** Benchmark commands are only checked here and run later by the
+    ** executor task.
+    */
+    if (Entry->Task == HUFF_APP_CmdTask_EXEC)
+    {
+        HUFF_APP_SubmitJob(SBBufPtr);
+    }
+    else
+    {
+        Entry->Handler(SBBufPtr);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Benchmark commands, run by the executor task. Their length has already     */
+/* been checked when they were queued.                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ProcessJob(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    const HUFF_APP_CmdEntry_t *Entry;
+    CFE_SB_MsgId_t             MsgId       = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t          CommandCode = 0;
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
+
+    if (CFE_SB_MsgIdToValue(MsgId) == HUFF_APP_CMD_WORK_MID)
+    {
+        return HUFF_APP_RunCmd((const HUFF_APP_RunCmd_t *)SBBufPtr);
+    }
+
+    /* Queued by the main task handler, for the counters the executor owns */
+    if (CommandCode == HUFF_APP_RESET_COUNTERS_CC)
+    {
+        return HUFF_APP_ResetJobCountersCmd((const HUFF_APP_ResetCountersCmd_t *)SBBufPtr);
+    }
+
+    Entry = HUFF_APP_CmdLookup(CommandCode);
+    if (Entry == NULL || Entry->Task != HUFF_APP_CmdTask_EXEC)
+    {
+        return CFE_STATUS_BAD_COMMAND_CODE;
+    }
+
+    return Entry->Handler(SBBufPtr);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Route a message received on the command pipe, after checking its length   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ProcessMsg(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+
+    switch (CFE_SB_MsgIdToValue(MsgId))
+    {
+        case HUFF_APP_CMD_MID:
+            HUFF_APP_ProcessGroundCommand(SBBufPtr);
+            break;
+
+        case HUFF_APP_CMD_WORK_MID:
+            /* A full queue means the runs are slower than the schedule: counted in HK, no event */
+            if (HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HUFF_APP_RunCmd_t)) &&
+                HUFF_APP_ExecSubmit(SBBufPtr) != CFE_SUCCESS)
+            {
+                HUFF_APP_Data.DroppedMsgCount++;
+            }
+            break;
+
+        case HUFF_APP_SEND_HK_MID:
+            if (HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HUFF_APP_SendHkCmd_t)))
+            {
+                HUFF_APP_SendHkCmd((const HUFF_APP_SendHkCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case HUFF_APP_TLMC_WAKEUP_MID:
+            if (HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HUFF_APP_TlmcWakeupCmd_t)))
+            {
+                HUFF_APP_TlmcWakeupCmd((const HUFF_APP_TlmcWakeupCmd_t *)SBBufPtr);
+            }
+            break;
+
+        default:
+            CFE_EVS_SendEvent(HUFF_APP_MID_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
+            HUFF_APP_Data.DroppedMsgCount++;
+            break;
+    }
+}
@@ -0,0 +1,515 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App in-app Huffman codec.
+ *
+ *   Code books are canonical and length-limited to HUFF_APP_CODEC_MAX_CODE_LEN
+ *   bits. Bit streams are written most significant bit first. Nothing in
+ *   this file allocates memory.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_codec.h"
+
+#define HUFF_APP_CODEC_MAX_NODES (2 * HUFF_APP_CODEC_SYMBOLS)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Symbol frequencies of a buffer                                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_CodecHistogram(const uint8 *Data, size_t Length, uint32 *Hist)
+{
+    size_t i;
+
+    memset(Hist, 0, HUFF_APP_CODEC_SYMBOLS * sizeof(Hist[0]));
+
+    for (i = 0; i < Length; i++)
+    {
+        Hist[Data[i]]++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Huffman code lengths of the symbols with a non-zero weight, using the      */
+/* two-queue construction over leaves sorted by weight. Returns the longest   */
+/* code length.                                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_CodecHuffmanLengths(const uint32 *Weight, uint8 *Lengths)
+{
+    uint16 Leaf[HUFF_APP_CODEC_SYMBOLS];
+    uint32 NodeWeight[HUFF_APP_CODEC_MAX_NODES];
+    uint16 Parent[HUFF_APP_CODEC_MAX_NODES];
+    uint8  Depth[HUFF_APP_CODEC_MAX_NODES];
+    uint32 NumLeaves = 0;
+    uint32 NextLeaf;
+    uint32 NextNode;
+    uint32 NumNodes;
+    uint32 Pick[2];
+    uint32 MaxLen = 0;
+    uint32 i;
+    uint32 j;
+    uint16 Tmp;
+
+    memset(Lengths, 0, HUFF_APP_CODEC_SYMBOLS);
+
+    /* Leaves in ascending weight order (insertion sort, at most 256 entries) */
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Weight[i] != 0)
+        {
+            Leaf[NumLeaves] = i;
+            for (j = NumLeaves; j > 0 && Weight[Leaf[j - 1]] > Weight[Leaf[j]]; j--)
+            {
+                Tmp         = Leaf[j - 1];
+                Leaf[j - 1] = Leaf[j];
+                Leaf[j]     = Tmp;
+            }
+            NumLeaves++;
+        }
+    }
+
+    if (NumLeaves == 0)
+    {
+        return 0;
+    }
+    if (NumLeaves == 1)
+    {
+        Lengths[Leaf[0]] = 1;
+        return 1;
+    }
+
+    /* Nodes 0..NumLeaves-1 are the leaves, internal nodes follow in creation order */
+    for (i = 0; i < NumLeaves; i++)
+    {
+        NodeWeight[i] = Weight[Leaf[i]];
+    }
+
+    NextLeaf = 0;
+    NextNode = NumLeaves;
+    NumNodes = NumLeaves;
+    while (NumNodes < 2 * NumLeaves - 1)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            if (NextLeaf < NumLeaves && (NextNode >= NumNodes || NodeWeight[NextLeaf] <= NodeWeight[NextNode]))
+            {
+                Pick[j] = NextLeaf++;
+            }
+            else
+            {
+                Pick[j] = NextNode++;
+            }
+        }
+
+        NodeWeight[NumNodes] = NodeWeight[Pick[0]] + NodeWeight[Pick[1]];
+        Parent[Pick[0]]      = NumNodes;
+        Parent[Pick[1]]      = NumNodes;
+        NumNodes++;
+    }
+
+    /* Parents always have a higher index than their children */
+    Depth[NumNodes - 1] = 0;
+    for (i = NumNodes - 1; i-- > 0;)
+    {
+        Depth[i] = Depth[Parent[i]] + 1;
+    }
+
+    for (i = 0; i < NumLeaves; i++)
+    {
+        Lengths[Leaf[i]] = Depth[i];
+        if (Depth[i] > MaxLen)
+        {
+            MaxLen = Depth[i];
+        }
+    }
+
+    return MaxLen;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Length-limited code lengths: weights are flattened until the Huffman code  */
+/* fits in HUFF_APP_CODEC_MAX_CODE_LEN bits                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_CodecBuildLengths(const uint32 *Hist, uint8 *Lengths)
+{
+    uint32 Weight[HUFF_APP_CODEC_SYMBOLS];
+    uint32 i;
+
+    memcpy(Weight, Hist, sizeof(Weight));
+
+    while (HUFF_APP_CodecHuffmanLengths(Weight, Lengths) > HUFF_APP_CODEC_MAX_CODE_LEN)
+    {
+        for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+        {
+            if (Weight[i] != 0)
+            {
+                Weight[i] = (Weight[i] >> 1) | 1;
+            }
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Canonical codes from code lengths. Fails when a length is out of range or  */
+/* the lengths over-subscribe the code space (Kraft inequality).              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_CodecBuildCodeBook(const uint8 *Lengths, HUFF_APP_CodeBook_t *Book)
+{
+    uint32 Count[HUFF_APP_CODEC_MAX_CODE_LEN + 1];
+    uint32 NextCode[HUFF_APP_CODEC_MAX_CODE_LEN + 1];
+    uint32 Kraft = 0;
+    uint32 Code  = 0;
+    uint32 Len;
+    uint32 i;
+
+    memset(Count, 0, sizeof(Count));
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Lengths[i] > HUFF_APP_CODEC_MAX_CODE_LEN)
+        {
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+        if (Lengths[i] != 0)
+        {
+            Count[Lengths[i]]++;
+            Kraft += 1u << (HUFF_APP_CODEC_MAX_CODE_LEN - Lengths[i]);
+        }
+    }
+
+    if (Kraft > HUFF_APP_CODEC_TABLE_SIZE)
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    for (Len = 1; Len <= HUFF_APP_CODEC_MAX_CODE_LEN; Len++)
+    {
+        Code          = (Code + Count[Len - 1]) << 1;
+        NextCode[Len] = Code;
+    }
+
+    memcpy(Book->Lengths, Lengths, sizeof(Book->Lengths));
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Book->Codes[i] = (Lengths[i] != 0) ? NextCode[Lengths[i]]++ : 0;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Fill the single lookup decode table of a code book                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_CodecBuildDecodeTable(const HUFF_APP_CodeBook_t *Book, HUFF_APP_DecodeTable_t *Table)
+{
+    uint32 Symbol;
+    uint32 Len;
+    uint32 First;
+    uint32 Span;
+    uint32 i;
+
+    memset(Table, 0, sizeof(*Table));
+
+    for (Symbol = 0; Symbol < HUFF_APP_CODEC_SYMBOLS; Symbol++)
+    {
+        Len = Book->Lengths[Symbol];
+        if (Len != 0)
+        {
+            First = (uint32)Book->Codes[Symbol] << (HUFF_APP_CODEC_MAX_CODE_LEN - Len);
+            Span  = 1u << (HUFF_APP_CODEC_MAX_CODE_LEN - Len);
+            for (i = 0; i < Span; i++)
+            {
+                Table->Entry[First + i] = (uint16)((Len << 8) | Symbol);
+            }
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Size of the encoded stream for a histogram, in bits                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint64 HUFF_APP_CodecEncodedBits(const HUFF_APP_CodeBook_t *Book, const uint32 *Hist)
+{
+    uint64 Bits = 0;
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Bits += (uint64)Hist[i] * Book->Lengths[i];
+    }
+
+    return Bits;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Encode a buffer. The last byte is padded with zero bits.                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_CodecEncode(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t Length, uint8 *Dst,
+                           size_t DstSize, size_t *EncodedBytes)
+{
+    uint64 Acc   = 0;
+    uint32 Count = 0;
+    uint8 *Out   = Dst;
+    uint8 *End   = Dst + DstSize;
+    uint32 Len;
+    size_t i;
+
+    *EncodedBytes = 0;
+
+    for (i = 0; i < Length; i++)
+    {
+        Len = Book->Lengths[Src[i]];
+        if (Len == 0)
+        {
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+
+        Acc = (Acc << Len) | Book->Codes[Src[i]];
+        Count += Len;
+
+        while (Count >= 8)
+        {
+            if (Out >= End)
+            {
+                return CFE_STATUS_RANGE_ERROR;
+            }
+            Count -= 8;
+            *Out++ = (uint8)(Acc >> Count);
+        }
+    }
+
+    if (Count > 0)
+    {
+        if (Out >= End)
+        {
+            return CFE_STATUS_RANGE_ERROR;
+        }
+        *Out++ = (uint8)(Acc << (8 - Count));
+    }
+
+    *EncodedBytes = Out - Dst;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Block index: the bit offset of every BlockSymbols-th symbol of the encoded */
+/* stream, so that any block can be decoded on its own. Returns the number of */
+/* entries written, 0 when the index does not fit.                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+size_t HUFF_APP_CodecBuildIndex(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t Length,
+                                uint32 BlockSymbols, uint32 *Index, size_t MaxEntries)
+{
+    uint64 BitOffset = 0;
+    size_t Entries;
+    size_t i;
+
+    if (BlockSymbols == 0)
+    {
+        return 0;
+    }
+
+    Entries = (Length + BlockSymbols - 1) / BlockSymbols;
+    if (Entries > MaxEntries)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < Length; i++)
+    {
+        if ((i % BlockSymbols) == 0)
+        {
+            /* Offsets of the largest workload fit in 32 bits (MAX_BYTES x MAX_CODE_LEN) */
+            Index[i / BlockSymbols] = (uint32)BitOffset;
+        }
+        BitOffset += Book->Lengths[Src[i]];
+    }
+
+    return Entries;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode NumSymbols symbols, one table lookup per symbol                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_CodecDecode(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes, uint8 *Dst,
+                           size_t NumSymbols)
+{
+    return HUFF_APP_CodecDecodeAt(Table, Src, SrcBytes, 0, Dst, NumSymbols);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode NumSymbols symbols starting BitOffset bits into the stream, as      */
+/* found in the block index                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_CodecDecodeAt(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes,
+                             uint64 BitOffset, uint8 *Dst, size_t NumSymbols)
+{
+    const uint8 *In       = Src + (BitOffset >> 3);
+    const uint8 *End      = Src + SrcBytes;
+    uint64       Bits     = 0;
+    uint32       Count    = 0;
+    uint64       Consumed = BitOffset;
+    uint32       Skip     = (uint32)(BitOffset & 7);
+    uint32       Entry;
+    uint32       Len;
+    size_t       i;
+
+    if (BitOffset > (uint64)SrcBytes * 8)
+    {
+        return CFE_STATUS_WRONG_MSG_LENGTH;
+    }
+
+    /* Drop the bits of the first byte that belong to the previous block */
+    if (Skip != 0)
+    {
+        Bits  = (uint64)((In < End) ? *In++ : 0) << (56 + Skip);
+        Count = 8 - Skip;
+    }
+
+    for (i = 0; i < NumSymbols; i++)
+    {
+        /* Keep at least 56 bits buffered, past the end of the stream with zeros */
+        if (Count < HUFF_APP_CODEC_MAX_CODE_LEN)
+        {
+            while (Count <= 56)
+            {
+                Bits |= (uint64)((In < End) ? *In++ : 0) << (56 - Count);
+                Count += 8;
+            }
+        }
+
+        Entry = Table->Entry[Bits >> (64 - HUFF_APP_CODEC_MAX_CODE_LEN)];
+        Len   = Entry >> 8;
+        if (Len == 0)
+        {
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+
+        Dst[i] = (uint8)Entry;
+        Bits <<= Len;
+        Count -= Len;
+        Consumed += Len;
+    }
+
+    if (Consumed > (uint64)SrcBytes * 8)
+    {
+        return CFE_STATUS_WRONG_MSG_LENGTH;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode NumSymbols symbols one bit at a time from the code lengths alone,   */
+/* as a reference kernel without any decode table                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_CodecDecodeSerial(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t SrcBytes, uint8 *Dst,
+                                 size_t NumSymbols)
+{
+    uint32 Count[HUFF_APP_CODEC_MAX_CODE_LEN + 1];
+    uint32 Next[HUFF_APP_CODEC_MAX_CODE_LEN + 1];
+    uint8  Sorted[HUFF_APP_CODEC_SYMBOLS];
+    uint64 BitPos    = 0;
+    uint64 TotalBits = (uint64)SrcBytes * 8;
+    uint32 Code;
+    uint32 First;
+    uint32 Index;
+    uint32 Len;
+    size_t i;
+
+    /* Symbols ordered by code length then value, the order canonical codes are assigned in */
+    memset(Count, 0, sizeof(Count));
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Count[Book->Lengths[i]]++;
+    }
+    Next[1] = 0;
+    for (Len = 1; Len < HUFF_APP_CODEC_MAX_CODE_LEN; Len++)
+    {
+        Next[Len + 1] = Next[Len] + Count[Len];
+    }
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Book->Lengths[i] != 0)
+        {
+            Sorted[Next[Book->Lengths[i]]++] = (uint8)i;
+        }
+    }
+
+    for (i = 0; i < NumSymbols; i++)
+    {
+        Code  = 0;
+        First = 0;
+        Index = 0;
+
+        /* Codes of each length are consecutive, starting at First */
+        for (Len = 1; Len <= HUFF_APP_CODEC_MAX_CODE_LEN; Len++)
+        {
+            if (BitPos >= TotalBits)
+            {
+                return CFE_STATUS_WRONG_MSG_LENGTH;
+            }
+
+            Code |= (Src[BitPos >> 3] >> (7 - (BitPos & 7))) & 1;
+            BitPos++;
+
+            if (Code - First < Count[Len])
+            {
+                Dst[i] = Sorted[Index + Code - First];
+                break;
+            }
+
+            Index += Count[Len];
+            First = (First + Count[Len]) << 1;
+            Code <<= 1;
+        }
+
+        if (Len > HUFF_APP_CODEC_MAX_CODE_LEN)
+        {
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+    }
+
+    return CFE_SUCCESS;
+}
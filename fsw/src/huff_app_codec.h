@@ -0,0 +1,71 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App in-app Huffman codec
+ */
+
+#ifndef HUFF_APP_CODEC_H
+#define HUFF_APP_CODEC_H
+
+/*
+** Required header files.
+*/
+#include "common_types.h"
+#include "huff_app_mission_cfg.h"
+
+#define HUFF_APP_CODEC_TABLE_SIZE (1 << HUFF_APP_CODEC_MAX_CODE_LEN)
+
+/*
+** Canonical code book: code lengths (0 for unused symbols) and the
+** codes derived from them, right aligned
+*/
+typedef struct
+{
+    uint8  Lengths[HUFF_APP_CODEC_SYMBOLS];
+    uint16 Codes[HUFF_APP_CODEC_SYMBOLS];
+} HUFF_APP_CodeBook_t;
+
+/*
+** Single lookup decode table, indexed by the next HUFF_APP_CODEC_MAX_CODE_LEN
+** bits of the stream. Each entry is (Length << 8) | Symbol, 0 for bit
+** patterns that are not a valid code.
+*/
+typedef struct
+{
+    uint16 Entry[HUFF_APP_CODEC_TABLE_SIZE];
+} HUFF_APP_DecodeTable_t;
+
+void   HUFF_APP_CodecHistogram(const uint8 *Data, size_t Length, uint32 *Hist);
+void   HUFF_APP_CodecBuildLengths(const uint32 *Hist, uint8 *Lengths);
+int32  HUFF_APP_CodecBuildCodeBook(const uint8 *Lengths, HUFF_APP_CodeBook_t *Book);
+void   HUFF_APP_CodecBuildDecodeTable(const HUFF_APP_CodeBook_t *Book, HUFF_APP_DecodeTable_t *Table);
+uint64 HUFF_APP_CodecEncodedBits(const HUFF_APP_CodeBook_t *Book, const uint32 *Hist);
+int32  HUFF_APP_CodecEncode(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t Length, uint8 *Dst,
+                            size_t DstSize, size_t *EncodedBytes);
+size_t HUFF_APP_CodecBuildIndex(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t Length,
+                                uint32 BlockSymbols, uint32 *Index, size_t MaxEntries);
+int32  HUFF_APP_CodecDecode(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes, uint8 *Dst,
+                            size_t NumSymbols);
+int32  HUFF_APP_CodecDecodeAt(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes,
+                              uint64 BitOffset, uint8 *Dst, size_t NumSymbols);
+int32  HUFF_APP_CodecDecodeSerial(const HUFF_APP_CodeBook_t *Book, const uint8 *Src, size_t SrcBytes, uint8 *Dst,
+                                  size_t NumSymbols);
+
+#endif /* HUFF_APP_CODEC_H */
@@ -0,0 +1,299 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App input corpus.
+ *
+ *   A corpus is a file of real data bytes. It is encoded once with a code
+ *   book built from its own statistics, and scheduled runs then time the
+ *   decoding of the encoded stream. On Linux the file is mapped and encoded
+ *   in place; on other targets it is read in chunks into the workload source
+ *   buffer. Only the first HUFF_APP_WORKLOAD_MAX_BYTES bytes are used.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_corpus.h"
+#include "huff_app_eventids.h"
+#include "huff_app_gen.h"
+#include "huff_app_service.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+typedef struct
+{
+    char         FileName[HUFF_APP_FILENAME_LEN];
+    const uint8 *Data;
+    size_t       Length;
+    uint32       Crc;
+
+    void * MapAddr; /* Mapping of the whole file, Linux only */
+    size_t MapLength;
+
+    HUFF_APP_Workload_t Workload;
+} HUFF_APP_CorpusData_t;
+
+static HUFF_APP_CorpusData_t HUFF_APP_CorpusData;
+
+#ifdef __linux__
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Map the corpus file read-only, without copying it                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t HUFF_APP_CorpusRead(const char *FileName)
+{
+    char        LocalPath[OS_MAX_LOCAL_PATH_LEN];
+    struct stat FileStat;
+    void *      Addr;
+    int         fd;
+
+    if (OS_TranslatePath(FileName, LocalPath) != OS_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    fd = open(LocalPath, O_RDONLY);
+    if (fd < 0)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (fstat(fd, &FileStat) != 0 || FileStat.st_size == 0)
+    {
+        close(fd);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    Addr = mmap(NULL, FileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (Addr == MAP_FAILED)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    madvise(Addr, FileStat.st_size, MADV_SEQUENTIAL);
+
+    HUFF_APP_CorpusData.MapAddr   = Addr;
+    HUFF_APP_CorpusData.MapLength = FileStat.st_size;
+    HUFF_APP_CorpusData.Data      = Addr;
+    HUFF_APP_CorpusData.Length    = FileStat.st_size;
+
+    return CFE_SUCCESS;
+}
+
+static void HUFF_APP_CorpusRelease(void)
+{
+    if (HUFF_APP_CorpusData.MapAddr != NULL)
+    {
+        munmap(HUFF_APP_CorpusData.MapAddr, HUFF_APP_CorpusData.MapLength);
+        HUFF_APP_CorpusData.MapAddr   = NULL;
+        HUFF_APP_CorpusData.MapLength = 0;
+    }
+}
+
+#else /* !__linux__ */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Read the corpus file in chunks into the workload source buffer             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t HUFF_APP_CorpusRead(const char *FileName)
+{
+    osal_id_t FileId;
+    int32     OsStatus;
+    size_t    Length = 0;
+    size_t    Chunk;
+
+    OsStatus = OS_OpenCreate(&FileId, FileName, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (OsStatus != OS_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    while (Length < sizeof(HUFF_APP_WorkloadSrcBuf))
+    {
+        Chunk = sizeof(HUFF_APP_WorkloadSrcBuf) - Length;
+        if (Chunk > HUFF_APP_CORPUS_CHUNK_SIZE)
+        {
+            Chunk = HUFF_APP_CORPUS_CHUNK_SIZE;
+        }
+
+        OsStatus = OS_read(FileId, &HUFF_APP_WorkloadSrcBuf[Length], Chunk);
+        if (OsStatus <= 0)
+        {
+            break;
+        }
+        Length += OsStatus;
+    }
+
+    OS_close(FileId);
+
+    if (OsStatus < 0 || Length == 0)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    HUFF_APP_CorpusData.Data   = HUFF_APP_WorkloadSrcBuf;
+    HUFF_APP_CorpusData.Length = Length;
+
+    return CFE_SUCCESS;
+}
+
+static void HUFF_APP_CorpusRelease(void) {}
+
+#endif /* __linux__ */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Release the corpus and return to seed mode                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_CorpusUnload(void)
+{
+    HUFF_APP_CorpusRelease();
+
+    HUFF_APP_CorpusData.Data           = NULL;
+    HUFF_APP_CorpusData.Length         = 0;
+    HUFF_APP_CorpusData.Workload.Valid = false;
+
+    if (HUFF_APP_Data.InputMode == HUFF_APP_InputMode_CORPUS)
+    {
+        HUFF_APP_Data.InputMode = HUFF_APP_InputMode_SEED;
+        HUFF_APP_ServiceSetBook(0, NULL);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Load a corpus file, encode it, and select corpus mode                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_CorpusLoad(const char *FileName)
+{
+    CFE_Status_t status;
+    size_t       Length;
+
+    /* The corpus replaces any generated input in the workload buffers, even when it fails to load */
+    HUFF_APP_CorpusUnload();
+    HUFF_APP_GenUnload();
+
+    status = HUFF_APP_CorpusRead(FileName);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_CORPUS_ERR_EID, CFE_EVS_EventType_ERROR, "HUFF: Failed to read corpus %s",
+                          FileName);
+        return status;
+    }
+
+    Length = HUFF_APP_CorpusData.Length;
+    if (Length > HUFF_APP_WORKLOAD_MAX_BYTES)
+    {
+        Length = HUFF_APP_WORKLOAD_MAX_BYTES;
+    }
+
+    status = HUFF_APP_WorkloadPrepare(&HUFF_APP_CorpusData.Workload, HUFF_APP_CorpusData.Data, Length,
+                                      HUFF_APP_WorkloadEncBuf, sizeof(HUFF_APP_WorkloadEncBuf),
+                                      HUFF_APP_WorkloadIndexBuf, HUFF_APP_WORKLOAD_INDEX_ENTRIES);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_CORPUS_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to encode corpus %s, RC = 0x%08lX", FileName, (unsigned long)status);
+        HUFF_APP_CorpusUnload();
+        return status;
+    }
+
+    strncpy(HUFF_APP_CorpusData.FileName, FileName, sizeof(HUFF_APP_CorpusData.FileName) - 1);
+    HUFF_APP_CorpusData.FileName[sizeof(HUFF_APP_CorpusData.FileName) - 1] = '\0';
+    HUFF_APP_CorpusData.Crc = CFE_ES_CalculateCRC(HUFF_APP_CorpusData.Data, Length, 0, CFE_MISSION_ES_DEFAULT_CRC);
+
+    HUFF_APP_Data.InputMode = HUFF_APP_InputMode_CORPUS;
+    HUFF_APP_ServiceSetBook(0, &HUFF_APP_CorpusData.Workload.Book);
+
+    CFE_EVS_SendEvent(HUFF_APP_CORPUS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Corpus %s loaded, CRC 0x%08lX, %lu of %lu bytes, %lu encoded bytes", FileName,
+                      (unsigned long)HUFF_APP_CorpusData.Crc, (unsigned long)Length,
+                      (unsigned long)HUFF_APP_CorpusData.Length,
+                      (unsigned long)HUFF_APP_CorpusData.Workload.EncodedBytes);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Time the decoding of the corpus and report its throughput                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_CorpusRun(void)
+{
+    const HUFF_APP_Workload_t *Workload = &HUFF_APP_CorpusData.Workload;
+    HUFF_APP_DecodeResult_t    Result;
+    HUFF_APP_Report_t          Report;
+    int64                      StartMicros;
+
+    if (!Workload->Valid)
+    {
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+    HUFF_APP_WorkloadMeasure(Workload, Workload->Length, HUFF_APP_WorkloadOutBuf, &Result);
+
+    if (Result.Status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: Corpus decode failed: 0x%08lx", (unsigned long)Result.Status);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUCP");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddHexU32(&Report, HUFF_APP_CorpusData.Crc);
+    HUFF_APP_ReportAddU32(&Report, Workload->Length);
+    HUFF_APP_ReportAddU32(&Report, Workload->EncodedBytes);
+    HUFF_APP_ReportAddU32(&Report, Result.Iterations);
+    HUFF_APP_ReportAddU32(&Report, Result.DurationMicros);
+    HUFF_APP_ReportAddHexU32(&Report, Result.Status);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultKiloBytesPerSec(&Result));
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultPicosPerSymbol(&Result));
+    HUFF_APP_ReportSend(&Report);
+
+    return Result.Status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Encoded corpus, for the commands that decode it in other ways              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_Workload_t *HUFF_APP_CorpusWorkload(void)
+{
+    return &HUFF_APP_CorpusData.Workload;
+}
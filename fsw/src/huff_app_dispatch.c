@@ -18,7 +18,11 @@
 
 /**
  * \file
- *   This file contains the source code for the Sample App.
+ *   This file contains the message dispatch of the HUFF App.
+ *
+ *   EDS and non-EDS builds share it: messages go through the same length
+ *   checks and command table, the command codes and types coming from the
+ *   EDS generated headers under the same names in an EDS build.
  */
 
 /*
@@ -26,116 +30,15 @@
 */
 #include "huff_app.h"
 #include "huff_app_dispatch.h"
-#include "huff_app_cmds.h"
-#include "huff_app_eventids.h"
-#include "huff_app_msgids.h"
-#include "huff_app_msg.h"
-
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*                                                                            */
-/* Verify command packet length                                               */
-/*                                                                            */
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-bool HUFF_APP_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
-{
-    bool              result       = true;
-    size_t            ActualLength = 0;
-    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
-    CFE_MSG_FcnCode_t FcnCode      = 0;
-
-    CFE_MSG_GetSize(MsgPtr, &ActualLength);
-
-    /*
-    ** Verify the command packet length.
-    */
-    if (ExpectedLength != ActualLength)
-    {
-        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
-        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
-
-        CFE_EVS_SendEvent(HUFF_APP_CMD_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u",
-                          (unsigned int)CFE_SB_MsgIdToValue(MsgId), (unsigned int)FcnCode, (unsigned int)ActualLength,
-                          (unsigned int)ExpectedLength);
-
-        result = false;
-
-        HUFF_APP_Data.ErrCounter++;
-    }
-
-    return result;
-}
-
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*                                                                            */
-/* SAMPLE ground commands                                                     */
-/*                                                                            */
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-void HUFF_APP_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr)
-{
-    CFE_MSG_FcnCode_t CommandCode = 0;
-
-    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
-
-    /*
-    ** Process SAMPLE app ground commands
-    */
-    switch (CommandCode)
-    {
-        case HUFF_APP_NOOP_CC:
-            if (HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HUFF_APP_NoopCmd_t)))
-            {
-                HUFF_APP_NoopCmd((const HUFF_APP_NoopCmd_t *)SBBufPtr);
-            }
-            break;
-
-        case HUFF_APP_RESET_COUNTERS_CC:
-            if (HUFF_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HUFF_APP_ResetCountersCmd_t)))
-            {
-                HUFF_APP_ResetCountersCmd((const HUFF_APP_ResetCountersCmd_t *)SBBufPtr);
-            }
-            break;
-
-        /* default case already found during FC vs length test */
-        default:
-            CFE_EVS_SendEvent(HUFF_APP_CC_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid ground command code: CC = %d",
-                              CommandCode);
-            break;
-    }
-}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /*  Purpose:                                                                  */
-/*     This routine will process any packet that is received on the SAMPLE    */
+/*     This routine will process any packet that is received on the HUFF      */
 /*     command pipe.                                                          */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 void HUFF_APP_TaskPipe(const CFE_SB_Buffer_t *SBBufPtr)
 {
-    CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
-
-    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
-
-
-
-    switch (CFE_SB_MsgIdToValue(MsgId))
-    {
-        case HUFF_APP_CMD_MID:
-            HUFF_APP_ProcessGroundCommand(SBBufPtr);
-            break;
-
-        case HUFF_APP_CMD_WORK_MID:
-            HUFF_APP_RunCmd((const HUFF_APP_RunCmd_t *)SBBufPtr);
-            break;
-
-        case HUFF_APP_SEND_HK_MID:
-            HUFF_APP_SendHkCmd((const HUFF_APP_SendHkCmd_t *)SBBufPtr);
-            break;
-
-        default:
-            CFE_EVS_SendEvent(HUFF_APP_MID_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "HUFF: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
-            break;
-    }
+    HUFF_APP_ProcessMsg(SBBufPtr);
 }
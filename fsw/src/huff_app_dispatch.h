@@ -19,7 +19,7 @@
 /**
  * @file
  *
- * Main header file for the SAMPLE application
+ * Message dispatch of the HUFF application
  */
 
 #ifndef HUFF_APP_DISPATCH_H
@@ -31,8 +31,10 @@
 #include "cfe.h"
 #include "huff_app_msg.h"
 
-void HUFF_APP_TaskPipe(const CFE_SB_Buffer_t *SBBufPtr);
-void HUFF_APP_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr);
-bool HUFF_APP_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
+void         HUFF_APP_TaskPipe(const CFE_SB_Buffer_t *SBBufPtr);
+void         HUFF_APP_ProcessMsg(const CFE_SB_Buffer_t *SBBufPtr);
+void         HUFF_APP_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr);
+CFE_Status_t HUFF_APP_ProcessJob(const CFE_SB_Buffer_t *SBBufPtr);
+bool         HUFF_APP_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
 
 #endif /* HUFF_APP_DISPATCH_H */
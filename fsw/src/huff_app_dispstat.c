@@ -0,0 +1,253 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App dispatch statistics.
+ *
+ *   Every message is accounted in a slot chosen by its MID and, for ground
+ *   commands, its command code: how many were received, how many failed
+ *   the length check, and the total and longest handling time. Benchmark
+ *   commands have a second slot for their run on the executor task, so the
+ *   main task slots only hold the time to queue them.
+ *
+ *   Main task slots are only written by the main task and executor slots
+ *   by the executor, each resetting its own. The dump runs on the executor
+ *   and reads the main task slots as they are updated: their times are
+ *   atomic, so they cannot be read torn.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdatomic.h>
+
+#include "huff_app.h"
+#include "huff_app_dispstat.h"
+#include "huff_app_duty.h"
+#include "huff_app_exec.h"
+#include "huff_app_msgids.h"
+#include "huff_app_utils.h"
+
+/* The last command code slot is shared by the codes above the maximum */
+#define HUFF_APP_DISPSTAT_CC_SLOTS (HUFF_APP_DISPSTAT_MAX_CC + 2)
+
+/*
+** Slot layout: ground command codes, the same codes run by the executor,
+** then one slot per other MID
+*/
+enum
+{
+    HUFF_APP_DispStat_GROUND_CC   = 0,
+    HUFF_APP_DispStat_JOB_CC      = HUFF_APP_DISPSTAT_CC_SLOTS,
+    HUFF_APP_DispStat_WORK        = 2 * HUFF_APP_DISPSTAT_CC_SLOTS,
+    HUFF_APP_DispStat_WORK_JOB,
+    HUFF_APP_DispStat_SEND_HK,
+    HUFF_APP_DispStat_TLMC_WAKEUP,
+    HUFF_APP_DispStat_OTHER_MID,
+    HUFF_APP_DispStat_SLOTS
+};
+
+typedef struct
+{
+    uint32 Count;       /* Messages received, rejected ones included */
+    uint32 Rejects;     /* Messages that failed the length check */
+    uint32 LastMsgId;   /* Identifies the shared slots in the dump */
+    uint16 LastFcnCode;
+    uint16 spare;
+    atomic_ullong TotalTicks;
+    atomic_ullong MaxTicks;
+} HUFF_APP_DispStatSlot_t;
+
+typedef struct
+{
+    HUFF_APP_DispStatSlot_t Slot[HUFF_APP_DispStat_SLOTS];
+} HUFF_APP_DispStatData_t;
+
+static HUFF_APP_DispStatData_t HUFF_APP_DispStatData;
+
+/* Slots written by the executor task */
+static bool HUFF_APP_DispStatIsJob(uint32 Index)
+{
+    return (Index >= HUFF_APP_DispStat_JOB_CC && Index < HUFF_APP_DispStat_WORK) ||
+           Index == HUFF_APP_DispStat_WORK_JOB;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Slot of a message, on the main task or the executor             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static HUFF_APP_DispStatSlot_t *HUFF_APP_DispStatSlot(const CFE_MSG_Message_t *MsgPtr, bool Job)
+{
+    HUFF_APP_DispStatSlot_t *Slot;
+    CFE_SB_MsgId_t           MsgId   = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t        FcnCode = 0;
+    uint32                   Index;
+
+    CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+
+    switch (CFE_SB_MsgIdToValue(MsgId))
+    {
+        case HUFF_APP_CMD_MID:
+            CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
+            Index = (FcnCode > HUFF_APP_DISPSTAT_MAX_CC) ? HUFF_APP_DISPSTAT_CC_SLOTS - 1 : FcnCode;
+            Index += Job ? HUFF_APP_DispStat_JOB_CC : HUFF_APP_DispStat_GROUND_CC;
+            break;
+
+        case HUFF_APP_CMD_WORK_MID:
+            Index = Job ? HUFF_APP_DispStat_WORK_JOB : HUFF_APP_DispStat_WORK;
+            break;
+
+        case HUFF_APP_SEND_HK_MID:
+            Index = HUFF_APP_DispStat_SEND_HK;
+            break;
+
+        case HUFF_APP_TLMC_WAKEUP_MID:
+            Index = HUFF_APP_DispStat_TLMC_WAKEUP;
+            break;
+
+        default:
+            Index = HUFF_APP_DispStat_OTHER_MID;
+            break;
+    }
+
+    Slot              = &HUFF_APP_DispStatData.Slot[Index];
+    Slot->LastMsgId   = CFE_SB_MsgIdToValue(MsgId);
+    Slot->LastFcnCode = FcnCode;
+
+    return Slot;
+}
+
+static void HUFF_APP_DispStatAdd(HUFF_APP_DispStatSlot_t *Slot, uint64 StartTicks)
+{
+    uint64 Ticks = HUFF_APP_DutyNow() - StartTicks;
+
+    Slot->Count++;
+    atomic_fetch_add(&Slot->TotalTicks, Ticks);
+    if (Ticks > atomic_load(&Slot->MaxTicks))
+    {
+        atomic_store(&Slot->MaxTicks, Ticks);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Account a message handled by the main task since StartTicks     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DispStatMsgDone(const CFE_SB_Buffer_t *SBBufPtr, uint64 StartTicks)
+{
+    HUFF_APP_DispStatAdd(HUFF_APP_DispStatSlot(&SBBufPtr->Msg, false), StartTicks);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Account a benchmark command run by the executor               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DispStatJobDone(const CFE_SB_Buffer_t *SBBufPtr, uint64 StartTicks)
+{
+    HUFF_APP_DispStatAdd(HUFF_APP_DispStatSlot(&SBBufPtr->Msg, true), StartTicks);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Account a command rejected by the length check, main task only  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DispStatReject(const CFE_MSG_Message_t *MsgPtr)
+{
+    HUFF_APP_DispStatSlot(MsgPtr, false)->Rejects++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Send one result sentence per slot in use, paced like the other  */
+/* dumps, and return their number                                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 HUFF_APP_DispStatDump(void)
+{
+    const HUFF_APP_DispStatSlot_t *Slot;
+    HUFF_APP_Report_t              Report;
+    uint64                         TotalMicros;
+    uint32                         Index;
+    uint32                         Sent = 0;
+
+    for (Index = 0; Index < HUFF_APP_DispStat_SLOTS && !HUFF_APP_ExecCancelled(); Index++)
+    {
+        Slot = &HUFF_APP_DispStatData.Slot[Index];
+        if (Slot->Count == 0 && Slot->Rejects == 0)
+        {
+            continue;
+        }
+
+        TotalMicros = HUFF_APP_DutyMicros(atomic_load(&Slot->TotalTicks));
+
+        HUFF_APP_ReportInit(&Report, "$HUDS");
+        HUFF_APP_ReportAddU32(&Report, Index);
+        HUFF_APP_ReportAddU32(&Report, HUFF_APP_DispStatIsJob(Index));
+        HUFF_APP_ReportAddHexU32(&Report, Slot->LastMsgId);
+        HUFF_APP_ReportAddU32(&Report, Slot->LastFcnCode);
+        HUFF_APP_ReportAddU32(&Report, Slot->Count);
+        HUFF_APP_ReportAddU32(&Report, Slot->Rejects);
+        HUFF_APP_ReportAddU32(&Report, (uint32)(TotalMicros / 1000));
+        HUFF_APP_ReportAddU32(&Report, (Slot->Count == 0) ? 0 : (uint32)(TotalMicros / Slot->Count));
+        HUFF_APP_ReportAddU32(&Report, (uint32)HUFF_APP_DutyMicros(atomic_load(&Slot->MaxTicks)));
+        HUFF_APP_ReportSend(&Report);
+        HUFF_APP_ReportPace(++Sent);
+    }
+
+    return Sent;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Reset the slots of the calling task                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HUFF_APP_DispStatReset(bool Job)
+{
+    HUFF_APP_DispStatSlot_t *Slot;
+    uint32                   Index;
+
+    for (Index = 0; Index < HUFF_APP_DispStat_SLOTS; Index++)
+    {
+        if (HUFF_APP_DispStatIsJob(Index) != Job)
+        {
+            continue;
+        }
+
+        Slot          = &HUFF_APP_DispStatData.Slot[Index];
+        Slot->Count   = 0;
+        Slot->Rejects = 0;
+        atomic_store(&Slot->TotalTicks, 0);
+        atomic_store(&Slot->MaxTicks, 0);
+    }
+}
+
+void HUFF_APP_DispStatResetStats(void)
+{
+    HUFF_APP_DispStatReset(false);
+}
+
+void HUFF_APP_DispStatResetJobStats(void)
+{
+    HUFF_APP_DispStatReset(true);
+}
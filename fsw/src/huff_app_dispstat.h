@@ -0,0 +1,39 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App dispatch statistics
+ */
+
+#ifndef HUFF_APP_DISPSTAT_H
+#define HUFF_APP_DISPSTAT_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+
+void   HUFF_APP_DispStatMsgDone(const CFE_SB_Buffer_t *SBBufPtr, uint64 StartTicks);
+void   HUFF_APP_DispStatJobDone(const CFE_SB_Buffer_t *SBBufPtr, uint64 StartTicks);
+void   HUFF_APP_DispStatReject(const CFE_MSG_Message_t *MsgPtr);
+uint32 HUFF_APP_DispStatDump(void);
+void   HUFF_APP_DispStatResetStats(void);
+void   HUFF_APP_DispStatResetJobStats(void);
+
+#endif /* HUFF_APP_DISPSTAT_H */
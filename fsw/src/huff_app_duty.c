@@ -0,0 +1,273 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App duty cycle accounting.
+ *
+ *   The main task is busy from the return of its pipe receive to the next
+ *   receive, and the executor task while it runs a job; the rest of the
+ *   time both are pended. Busy time is measured with the PSP timebase and
+ *   summed per kind of work. Each HK packet reports the busy share of both
+ *   tasks since the previous one, which is what their scheduler slots must
+ *   accommodate.
+ *
+ *   A job can span several HK intervals: the running part of the job is
+ *   counted in each interval, and the job only adds the part after the
+ *   latest interval start when it ends.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdatomic.h>
+
+#include "huff_app.h"
+#include "huff_app_duty.h"
+#include "huff_app_msgids.h"
+#include "huff_app_utils.h"
+
+typedef struct
+{
+    uint32 TicksPerSecond; /* 0 when the PSP has no timebase: accounting off */
+
+    /* Main task only, the JOB entries excepted */
+    uint64 MainBusyTicks; /* In the current interval */
+    uint64 MsgBusyTicks[HUFF_APP_DUTY_MSG_TYPES];
+    uint64 MsgMaxTicks[HUFF_APP_DUTY_MSG_TYPES];
+    uint32 MsgCount[HUFF_APP_DUTY_MSG_TYPES];
+
+    /* Shared with the executor task */
+    atomic_ullong IntervalStart;
+    atomic_ullong ExecJobStart;  /* 0 while no job runs */
+    atomic_ullong ExecBusyTicks; /* Completed job time in the current interval */
+
+    /* Written by the executor task only, read by HK */
+    atomic_ullong JobBusyTicks;
+    atomic_ullong JobMaxTicks;
+    atomic_uint   JobCount;
+} HUFF_APP_DutyData_t;
+
+static HUFF_APP_DutyData_t HUFF_APP_DutyData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Convert timebase ticks to microseconds                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 HUFF_APP_DutyMicros(uint64 Ticks)
+{
+    uint32 Tps = HUFF_APP_DutyData.TicksPerSecond;
+
+    if (Tps == 0)
+    {
+        return 0;
+    }
+
+    return (Ticks / Tps) * 1000000 + ((Ticks % Tps) * 1000000) / Tps;
+}
+
+static uint32 HUFF_APP_DutySaturate(uint64 Micros)
+{
+    return (Micros > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)Micros;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Busy share of an interval, in permille                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint16 HUFF_APP_DutyPermille(uint64 BusyTicks, uint64 WallTicks)
+{
+    if (WallTicks == 0)
+    {
+        return 0;
+    }
+
+    /* Jobs ending across an HK boundary can count a little twice */
+    if (BusyTicks >= WallTicks)
+    {
+        return 1000;
+    }
+
+    return (uint16)((BusyTicks * 1000) / WallTicks);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Current PSP timebase                                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 HUFF_APP_DutyNow(void)
+{
+    return HUFF_APP_GetTimebaseTicks();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Start the first accounting interval                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DutyInit(void)
+{
+    memset(&HUFF_APP_DutyData, 0, sizeof(HUFF_APP_DutyData));
+
+    HUFF_APP_DutyData.TicksPerSecond = CFE_PSP_GetTimerTicksPerSecond();
+    atomic_store(&HUFF_APP_DutyData.IntervalStart, HUFF_APP_DutyNow());
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Account a message handled by the main task since StartTicks     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DutyMsgDone(const CFE_SB_Buffer_t *SBBufPtr, uint64 StartTicks)
+{
+    HUFF_APP_DutyData_t *Data  = &HUFF_APP_DutyData;
+    CFE_SB_MsgId_t       MsgId = CFE_SB_INVALID_MSG_ID;
+    uint64               Busy  = HUFF_APP_DutyNow() - StartTicks;
+    uint32               Type;
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+
+    switch (CFE_SB_MsgIdToValue(MsgId))
+    {
+        case HUFF_APP_CMD_MID:
+            Type = HUFF_APP_DutyMsg_GROUND_CMD;
+            break;
+
+        case HUFF_APP_CMD_WORK_MID:
+            Type = HUFF_APP_DutyMsg_WORK;
+            break;
+
+        case HUFF_APP_SEND_HK_MID:
+            Type = HUFF_APP_DutyMsg_SEND_HK;
+            break;
+
+        case HUFF_APP_TLMC_WAKEUP_MID:
+            Type = HUFF_APP_DutyMsg_TLMC_WAKEUP;
+            break;
+
+        default:
+            Type = HUFF_APP_DutyMsg_OTHER;
+            break;
+    }
+
+    Data->MainBusyTicks += Busy;
+    Data->MsgBusyTicks[Type] += Busy;
+    Data->MsgCount[Type]++;
+    if (Busy > Data->MsgMaxTicks[Type])
+    {
+        Data->MsgMaxTicks[Type] = Busy;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Executor job start and end                                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DutyJobBegin(void)
+{
+    atomic_store(&HUFF_APP_DutyData.ExecJobStart, HUFF_APP_DutyNow());
+}
+
+void HUFF_APP_DutyJobEnd(void)
+{
+    HUFF_APP_DutyData_t *Data = &HUFF_APP_DutyData;
+    uint64               End  = HUFF_APP_DutyNow();
+    uint64               Start;
+    uint64               Origin;
+
+    Start  = atomic_load(&Data->ExecJobStart);
+    Origin = atomic_load(&Data->IntervalStart);
+    if (Origin < Start)
+    {
+        Origin = Start;
+    }
+
+    atomic_fetch_add(&Data->ExecBusyTicks, End - Origin);
+    atomic_store(&Data->ExecJobStart, 0);
+
+    /* Job counters are only written here, and read by HK */
+    atomic_fetch_add(&Data->JobBusyTicks, End - Start);
+    atomic_fetch_add(&Data->JobCount, 1);
+    if (End - Start > atomic_load(&Data->JobMaxTicks))
+    {
+        atomic_store(&Data->JobMaxTicks, End - Start);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Housekeeping: duty cycle of the interval since the previous     */
+/* packet, which starts a new interval, and the totals per kind    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_DutyGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    HUFF_APP_DutyData_t *Data = &HUFF_APP_DutyData;
+    uint64               Now  = HUFF_APP_DutyNow();
+    uint64               Start;
+    uint64               Wall;
+    uint64               ExecBusy;
+    uint64               JobStart;
+    uint32               i;
+
+    Start = atomic_exchange(&Data->IntervalStart, Now);
+    Wall  = Now - Start;
+
+    ExecBusy = atomic_exchange(&Data->ExecBusyTicks, 0);
+    JobStart = atomic_load(&Data->ExecJobStart);
+    if (JobStart != 0)
+    {
+        ExecBusy += Now - ((JobStart > Start) ? JobStart : Start);
+    }
+
+    Hk->DutyIntervalMicros = HUFF_APP_DutySaturate(HUFF_APP_DutyMicros(Wall));
+    Hk->DutyPermille       = HUFF_APP_DutyPermille(Data->MainBusyTicks, Wall);
+    Hk->ExecDutyPermille   = HUFF_APP_DutyPermille(ExecBusy, Wall);
+    Data->MainBusyTicks    = 0;
+
+    Data->MsgCount[HUFF_APP_DutyMsg_JOB]     = atomic_load(&Data->JobCount);
+    Data->MsgBusyTicks[HUFF_APP_DutyMsg_JOB] = atomic_load(&Data->JobBusyTicks);
+    Data->MsgMaxTicks[HUFF_APP_DutyMsg_JOB]  = atomic_load(&Data->JobMaxTicks);
+
+    for (i = 0; i < HUFF_APP_DUTY_MSG_TYPES; i++)
+    {
+        Hk->DutyMsg[i].Count      = Data->MsgCount[i];
+        Hk->DutyMsg[i].BusyMicros = (uint32)HUFF_APP_DutyMicros(Data->MsgBusyTicks[i]);
+        Hk->DutyMsg[i].MaxMicros  = HUFF_APP_DutySaturate(HUFF_APP_DutyMicros(Data->MsgMaxTicks[i]));
+    }
+}
+
+/* Main task: the kinds of work it accounts */
+void HUFF_APP_DutyResetStats(void)
+{
+    memset(HUFF_APP_DutyData.MsgBusyTicks, 0, sizeof(HUFF_APP_DutyData.MsgBusyTicks));
+    memset(HUFF_APP_DutyData.MsgMaxTicks, 0, sizeof(HUFF_APP_DutyData.MsgMaxTicks));
+    memset(HUFF_APP_DutyData.MsgCount, 0, sizeof(HUFF_APP_DutyData.MsgCount));
+}
+
+/* Executor task: its jobs */
+void HUFF_APP_DutyResetJobStats(void)
+{
+    atomic_store(&HUFF_APP_DutyData.JobBusyTicks, 0);
+    atomic_store(&HUFF_APP_DutyData.JobMaxTicks, 0);
+    atomic_store(&HUFF_APP_DutyData.JobCount, 0);
+}
@@ -0,0 +1,367 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App benchmark executor.
+ *
+ *   Benchmark commands (scheduled runs, contended runs, calibration, input
+ *   loading, sweeps, parallel decodes, trace dumps and perf log captures)
+ *   can take seconds. Running them on the app main task would hold
+ *   housekeeping requests and the other commands in the command pipe, so
+ *   the main task copies them into a bounded single-producer/single-consumer
+ *   ring and an executor child task runs them in order. Completion is
+ *   reported with an event and the HK counters.
+ *
+ *   Each queued command gets a sequence number. Cancelling marks every
+ *   command submitted so far: queued ones are dropped when they reach the
+ *   executor and the running one stops at its next HUFF_APP_ExecCancelled()
+ *   check.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdatomic.h>
+
+#include "huff_app.h"
+#include "huff_app_bench.h"
+#include "huff_app_dispatch.h"
+#include "huff_app_dispstat.h"
+#include "huff_app_duty.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_msgids.h"
+#include "huff_app_perfctr.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+
+/* Keeps the producer and consumer indices in different cache lines */
+#define HUFF_APP_EXEC_LINE_SIZE 64
+
+/*
+** Largest command run by the executor
+*/
+typedef union
+{
+    CFE_SB_Buffer_t             SBBuf;
+    HUFF_APP_RunCmd_t           Run;
+    HUFF_APP_ContendCmd_t       Contend;
+    HUFF_APP_CalibrateCmd_t     Calibrate;
+    HUFF_APP_LoadCorpusCmd_t    LoadCorpus;
+    HUFF_APP_GenerateCmd_t      Generate;
+    HUFF_APP_SweepCmd_t         Sweep;
+    HUFF_APP_ParDecodeCmd_t     ParDecode;
+    HUFF_APP_TraceDumpCmd_t     TraceDump;
+    HUFF_APP_PerfCaptureCmd_t   PerfCapture;
+    HUFF_APP_BatchCmd_t         Batch;
+    HUFF_APP_ReplayCmd_t        Replay;
+    HUFF_APP_AbCompareCmd_t     AbCompare;
+    HUFF_APP_AdaptiveRunCmd_t   AdaptiveRun;
+    HUFF_APP_DispatchStatsCmd_t DispatchStats;
+} HUFF_APP_ExecMsg_t;
+
+typedef struct
+{
+    uint32             Seq;
+    HUFF_APP_ExecMsg_t Msg;
+} HUFF_APP_ExecSlot_t;
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    osal_id_t       WorkSem; /* One count per queued command */
+
+    /* Head is only written by the main task, Tail only by the executor */
+    atomic_uint Head __attribute__((aligned(HUFF_APP_EXEC_LINE_SIZE)));
+    atomic_uint Tail __attribute__((aligned(HUFF_APP_EXEC_LINE_SIZE)));
+    atomic_uint CancelSeq; /* Commands with a lower sequence number are cancelled */
+    atomic_bool Running;
+    uint32      RunningSeq;
+
+    HUFF_APP_ExecSlot_t Slot[HUFF_APP_EXEC_QUEUE_DEPTH];
+
+    uint32 JobsDone;
+    uint32 JobsCancelled;
+    uint32 JobsRejected;
+} HUFF_APP_ExecData_t;
+
+static HUFF_APP_ExecData_t HUFF_APP_ExecData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* True when sequence number A comes before B, across wrap-around            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static bool HUFF_APP_ExecBefore(uint32 A, uint32 B)
+{
+    return (int32)(A - B) < 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Commands waiting behind the running one                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_ExecQueued(bool Running)
+{
+    uint32 InRing = atomic_load(&HUFF_APP_ExecData.Head) - atomic_load(&HUFF_APP_ExecData.Tail);
+
+    /* The running command keeps its slot until it completes */
+    if (Running && InRing > 0)
+    {
+        InRing--;
+    }
+
+    return InRing;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* False for the executor half of RESET_COUNTERS: the main task already       */
+/* reported the reset, so a cancel must not drop it                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static bool HUFF_APP_ExecCancellable(CFE_SB_MsgId_t MsgId, CFE_MSG_FcnCode_t CommandCode)
+{
+    return CFE_SB_MsgIdToValue(MsgId) != HUFF_APP_CMD_MID || CommandCode != HUFF_APP_RESET_COUNTERS_CC;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Run one queued command and report its completion                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ExecRun(const HUFF_APP_ExecSlot_t *Slot)
+{
+    CFE_SB_MsgId_t    MsgId       = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t CommandCode = 0;
+    CFE_Status_t      status;
+    int64             StartMicros;
+    uint64            StartTicks;
+    bool              Cancellable;
+    bool              Cancelled;
+
+    CFE_MSG_GetMsgId(&Slot->Msg.SBBuf.Msg, &MsgId);
+    CFE_MSG_GetFcnCode(&Slot->Msg.SBBuf.Msg, &CommandCode);
+    Cancellable = HUFF_APP_ExecCancellable(MsgId, CommandCode);
+
+    if (Cancellable && HUFF_APP_ExecBefore(Slot->Seq, atomic_load(&HUFF_APP_ExecData.CancelSeq)))
+    {
+        HUFF_APP_ExecData.JobsCancelled++;
+        return;
+    }
+
+    HUFF_APP_ExecData.RunningSeq = Slot->Seq;
+    atomic_store(&HUFF_APP_ExecData.Running, true);
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+    CFE_ES_PerfLogEntry(HUFF_APP_EXEC_PERF_ID);
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DISPATCH);
+    HUFF_APP_DutyJobBegin();
+    StartTicks = HUFF_APP_DutyNow();
+    status     = HUFF_APP_ProcessJob(&Slot->Msg.SBBuf);
+    HUFF_APP_DispStatJobDone(&Slot->Msg.SBBuf, StartTicks);
+    HUFF_APP_DutyJobEnd();
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_DISPATCH);
+    CFE_ES_PerfLogExit(HUFF_APP_EXEC_PERF_ID);
+    Cancelled = Cancellable && HUFF_APP_ExecCancelled();
+
+    atomic_store(&HUFF_APP_ExecData.Running, false);
+
+    if (Cancelled)
+    {
+        HUFF_APP_ExecData.JobsCancelled++;
+    }
+    else
+    {
+        HUFF_APP_ExecData.JobsDone++;
+    }
+
+    /* Scheduled runs report through their result sentences, at the schedule rate */
+    if (CFE_SB_MsgIdToValue(MsgId) == HUFF_APP_CMD_MID)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_EXEC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "HUFF: Command %lu (CC %u) %s after %ld ms, RC = 0x%08lX", (unsigned long)Slot->Seq,
+                          (unsigned int)CommandCode, Cancelled ? "cancelled" : "done",
+                          (long)((HUFF_APP_GetTimeMicros() - StartMicros) / 1000), (unsigned long)status);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Executor child task entry point                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ExecTaskMain(void)
+{
+    unsigned int Tail;
+
+    HUFF_APP_TraceAttach("HUFF_EXEC");
+
+    /* The performance counters count the task that opens them */
+    HUFF_APP_PerfCtrInit();
+
+    /* Choose the number of benchmark invocations per timed sample */
+    HUFF_APP_BenchCalibrate(HUFF_APP_CALIB_MIN_SAMPLE_US);
+
+    while (OS_CountSemTake(HUFF_APP_ExecData.WorkSem) == OS_SUCCESS)
+    {
+        Tail = atomic_load_explicit(&HUFF_APP_ExecData.Tail, memory_order_relaxed);
+        if (Tail == atomic_load_explicit(&HUFF_APP_ExecData.Head, memory_order_acquire))
+        {
+            continue;
+        }
+
+        /* The slot stays owned by the executor until Tail moves past it */
+        HUFF_APP_ExecRun(&HUFF_APP_ExecData.Slot[Tail % HUFF_APP_EXEC_QUEUE_DEPTH]);
+
+        atomic_store_explicit(&HUFF_APP_ExecData.Tail, Tail + 1, memory_order_release);
+    }
+
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Start the executor task                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ExecInit(void)
+{
+    memset(&HUFF_APP_ExecData, 0, sizeof(HUFF_APP_ExecData));
+
+    if (OS_CountSemCreate(&HUFF_APP_ExecData.WorkSem, "HUFF_EXEC_SEM", 0, 0) != OS_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_ES_CreateChildTask(&HUFF_APP_ExecData.TaskId, "HUFF_EXEC", HUFF_APP_ExecTaskMain,
+                                  CFE_ES_TASK_STACK_ALLOCATE, HUFF_APP_EXEC_STACK_SIZE, HUFF_APP_EXEC_PRIORITY, 0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Queue a copy of a benchmark command. Only called from the app main task.   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ExecSubmit(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    HUFF_APP_ExecSlot_t *Slot;
+    size_t               Size = 0;
+    unsigned int         Head;
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+    if (Size > sizeof(Slot->Msg))
+    {
+        HUFF_APP_ExecData.JobsRejected++;
+        return CFE_STATUS_WRONG_MSG_LENGTH;
+    }
+
+    Head = atomic_load_explicit(&HUFF_APP_ExecData.Head, memory_order_relaxed);
+    if (Head - atomic_load_explicit(&HUFF_APP_ExecData.Tail, memory_order_acquire) >= HUFF_APP_EXEC_QUEUE_DEPTH)
+    {
+        HUFF_APP_ExecData.JobsRejected++;
+        return CFE_STATUS_REQUEST_ALREADY_PENDING;
+    }
+
+    Slot      = &HUFF_APP_ExecData.Slot[Head % HUFF_APP_EXEC_QUEUE_DEPTH];
+    Slot->Seq = Head;
+    memcpy(&Slot->Msg, SBBufPtr, Size);
+
+    atomic_store_explicit(&HUFF_APP_ExecData.Head, Head + 1, memory_order_release);
+    OS_CountSemGive(HUFF_APP_ExecData.WorkSem);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Cancel the queued commands and the running one. Returns the number of      */
+/* queued commands dropped.                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_ExecCancel(bool *WasRunning)
+{
+    const HUFF_APP_ExecSlot_t *Slot;
+    CFE_SB_MsgId_t             MsgId;
+    CFE_MSG_FcnCode_t          CommandCode;
+    unsigned int               Head;
+    unsigned int               Index;
+    uint32                     Dropped = 0;
+
+    *WasRunning = atomic_load(&HUFF_APP_ExecData.Running);
+
+    Head = atomic_load_explicit(&HUFF_APP_ExecData.Head, memory_order_relaxed);
+    atomic_store(&HUFF_APP_ExecData.CancelSeq, Head);
+
+    /* Queued slots are only written by this task, so they can be read here */
+    for (Index = Head - HUFF_APP_ExecQueued(*WasRunning); Index != Head; Index++)
+    {
+        Slot        = &HUFF_APP_ExecData.Slot[Index % HUFF_APP_EXEC_QUEUE_DEPTH];
+        MsgId       = CFE_SB_INVALID_MSG_ID;
+        CommandCode = 0;
+        CFE_MSG_GetMsgId(&Slot->Msg.SBBuf.Msg, &MsgId);
+        CFE_MSG_GetFcnCode(&Slot->Msg.SBBuf.Msg, &CommandCode);
+        if (HUFF_APP_ExecCancellable(MsgId, CommandCode))
+        {
+            Dropped++;
+        }
+    }
+
+    return Dropped;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* True when the running command has been cancelled. Long benchmark loops     */
+/* check it between samples.                                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool HUFF_APP_ExecCancelled(void)
+{
+    return HUFF_APP_ExecBefore(HUFF_APP_ExecData.RunningSeq, atomic_load(&HUFF_APP_ExecData.CancelSeq));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Housekeeping counters                                                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ExecGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    bool Running = atomic_load(&HUFF_APP_ExecData.Running);
+
+    Hk->ExecRunning       = Running;
+    Hk->ExecQueueDepth    = (uint8)HUFF_APP_ExecQueued(Running);
+    Hk->ExecJobsDone      = HUFF_APP_ExecData.JobsDone;
+    Hk->ExecJobsCancelled = HUFF_APP_ExecData.JobsCancelled;
+    Hk->ExecJobsRejected  = HUFF_APP_ExecData.JobsRejected;
+}
+
+void HUFF_APP_ExecResetStats(void)
+{
+    HUFF_APP_ExecData.JobsRejected = 0;
+}
+
+/* Executor task only: the reset job itself then counts as the first one done */
+void HUFF_APP_ExecResetJobStats(void)
+{
+    HUFF_APP_ExecData.JobsDone      = 0;
+    HUFF_APP_ExecData.JobsCancelled = 0;
+}
@@ -0,0 +1,514 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App synthetic input generator.
+ *
+ *   Symbols are drawn from a Walker alias table built for the requested
+ *   distribution, using xoshiro128** streams laid out so that the random
+ *   number loop can be vectorized. Generation and encoding happen outside
+ *   of any timed region; scheduled runs then decode the generated input,
+ *   or with a pipelined generator a new input per run (huff_app_genpipe.c).
+ */
+
+/*
+** Include Files:
+*/
+#include <math.h>
+
+#include "huff_app.h"
+#include "huff_app_corpus.h"
+#include "huff_app_eventids.h"
+#include "huff_app_gen.h"
+#include "huff_app_genpipe.h"
+#include "huff_app_service.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+/* Symbols generated per batch of random numbers */
+#define HUFF_APP_GEN_BLOCK 256
+
+typedef struct
+{
+    uint32 Threshold[HUFF_APP_CODEC_SYMBOLS]; /* Keep index i when the draw is below, else take Alias[i] */
+    uint8  Alias[HUFF_APP_CODEC_SYMBOLS];
+    uint32 Count;
+} HUFF_APP_GenAlias_t;
+
+typedef struct
+{
+    HUFF_APP_Generate_Payload_t Spec;
+    HUFF_APP_GenInput_t         Input;
+    HUFF_APP_Workload_t         Workload;
+} HUFF_APP_GenData_t;
+
+static HUFF_APP_GenData_t HUFF_APP_GenData;
+
+static inline uint32 HUFF_APP_GenRotl(uint32 x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Seed every lane from one 32 bit seed with splitmix32                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_GenRngSeed(HUFF_APP_GenRng_t *Rng, uint32 Seed)
+{
+    uint32 *Words = (uint32 *)Rng;
+    uint32  z;
+    size_t  i;
+
+    for (i = 0; i < sizeof(*Rng) / sizeof(uint32); i++)
+    {
+        Seed += 0x9E3779B9u;
+        z        = Seed;
+        z        = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z        = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        Words[i] = z ^ (z >> 16);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Fill Count words (a multiple of the lane count) with random numbers        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_GenRngFill(HUFF_APP_GenRng_t *Rng, uint32 *Out, size_t Count)
+{
+    uint32 t;
+    size_t i;
+    int    l;
+
+    for (i = 0; i + HUFF_APP_GEN_LANES <= Count; i += HUFF_APP_GEN_LANES)
+    {
+        for (l = 0; l < HUFF_APP_GEN_LANES; l++)
+        {
+            Out[i + l] = HUFF_APP_GenRotl(Rng->s1[l] * 5, 7) * 9;
+
+            t = Rng->s1[l] << 9;
+            Rng->s2[l] ^= Rng->s0[l];
+            Rng->s3[l] ^= Rng->s1[l];
+            Rng->s1[l] ^= Rng->s2[l];
+            Rng->s0[l] ^= Rng->s3[l];
+            Rng->s2[l] ^= t;
+            Rng->s3[l] = HUFF_APP_GenRotl(Rng->s3[l], 11);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Validate a generator specification                                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_GenCheckSpec(const HUFF_APP_Generate_Payload_t *Spec, size_t MaxLength)
+{
+    bool Valid;
+
+    Valid = (Spec->AlphabetSize >= 1 && Spec->AlphabetSize <= HUFF_APP_CODEC_SYMBOLS && Spec->Length >= 1 &&
+             Spec->Length <= MaxLength);
+
+    switch (Spec->Distribution)
+    {
+        case HUFF_APP_GenDist_UNIFORM:
+        case HUFF_APP_GenDist_ZIPF:
+            break;
+
+        case HUFF_APP_GenDist_GEOMETRIC:
+            Valid = Valid && (Spec->Param1 >= 1 && Spec->Param1 <= 1000);
+            break;
+
+        case HUFF_APP_GenDist_MIXTURE:
+            Valid = Valid && (Spec->Param1 >= 1 && Spec->Param1 <= Spec->AlphabetSize && Spec->Param2 <= 1000);
+            break;
+
+        case HUFF_APP_GenDist_RUNS:
+            Valid = Valid && (Spec->Param1 >= 1);
+            break;
+
+        default:
+            Valid = false;
+            break;
+    }
+
+    return Valid ? CFE_SUCCESS : CFE_STATUS_RANGE_ERROR;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Walker alias table of the distribution (Vose's construction)               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_GenBuildAlias(const HUFF_APP_Generate_Payload_t *Spec, HUFF_APP_GenAlias_t *Alias)
+{
+    double Prob[HUFF_APP_CODEC_SYMBOLS];
+    uint8  Small[HUFF_APP_CODEC_SYMBOLS];
+    uint8  Large[HUFF_APP_CODEC_SYMBOLS];
+    uint32 NumSmall = 0;
+    uint32 NumLarge = 0;
+    uint32 n        = Spec->AlphabetSize;
+    double Sum      = 0;
+    double HotProb;
+    uint32 s;
+    uint32 l;
+    uint32 k;
+
+    for (k = 0; k < n; k++)
+    {
+        switch (Spec->Distribution)
+        {
+            case HUFF_APP_GenDist_ZIPF:
+                Prob[k] = pow(k + 1, -(Spec->Param1 / 1000.0));
+                break;
+
+            case HUFF_APP_GenDist_GEOMETRIC:
+                Prob[k] = pow(1.0 - Spec->Param1 / 1000.0, k);
+                break;
+
+            case HUFF_APP_GenDist_MIXTURE:
+                HotProb = Spec->Param2 / 1000.0;
+                if (Spec->Param1 == n)
+                {
+                    Prob[k] = 1.0;
+                }
+                else if (k < Spec->Param1)
+                {
+                    Prob[k] = HotProb / Spec->Param1;
+                }
+                else
+                {
+                    Prob[k] = (1.0 - HotProb) / (n - Spec->Param1);
+                }
+                break;
+
+            default:
+                Prob[k] = 1.0;
+                break;
+        }
+
+        /* Keep every symbol of the alphabet representable */
+        if (Prob[k] < 1e-12)
+        {
+            Prob[k] = 1e-12;
+        }
+        Sum += Prob[k];
+    }
+
+    /* Scale so that the average bucket holds exactly 1 */
+    for (k = 0; k < n; k++)
+    {
+        Prob[k] = Prob[k] * n / Sum;
+        if (Prob[k] < 1.0)
+        {
+            Small[NumSmall++] = k;
+        }
+        else
+        {
+            Large[NumLarge++] = k;
+        }
+    }
+
+    while (NumSmall > 0 && NumLarge > 0)
+    {
+        s = Small[--NumSmall];
+        l = Large[--NumLarge];
+
+        Alias->Threshold[s] = (uint32)(Prob[s] * 4294967295.0);
+        Alias->Alias[s]     = l;
+
+        Prob[l] = (Prob[l] + Prob[s]) - 1.0;
+        if (Prob[l] < 1.0)
+        {
+            Small[NumSmall++] = l;
+        }
+        else
+        {
+            Large[NumLarge++] = l;
+        }
+    }
+
+    /* Whatever is left is 1 up to rounding */
+    while (NumLarge > 0)
+    {
+        l                   = Large[--NumLarge];
+        Alias->Threshold[l] = 0xFFFFFFFF;
+        Alias->Alias[l]     = l;
+    }
+    while (NumSmall > 0)
+    {
+        s                   = Small[--NumSmall];
+        Alias->Threshold[s] = 0xFFFFFFFF;
+        Alias->Alias[s]     = s;
+    }
+
+    Alias->Count = n;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Generate Length symbols following a (validated) specification              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_GenFill(const HUFF_APP_Generate_Payload_t *Spec, uint8 *Dst, size_t Length)
+{
+    HUFF_APP_GenAlias_t Alias;
+    HUFF_APP_GenRng_t   Rng;
+    uint32              Rand[3 * HUFF_APP_GEN_BLOCK];
+    uint32              RepeatThreshold = 0;
+    uint32              Index;
+    uint8               Symbol;
+    uint8               Previous = 0;
+    size_t              Done;
+    size_t              Block;
+    size_t              j;
+
+    HUFF_APP_GenBuildAlias(Spec, &Alias);
+    HUFF_APP_GenRngSeed(&Rng, Spec->Seed);
+
+    /* In run mode, a symbol repeats the previous one with probability 1 - 1/mean */
+    if (Spec->Distribution == HUFF_APP_GenDist_RUNS)
+    {
+        RepeatThreshold = (uint32)((1.0 - 1.0 / Spec->Param1) * 4294967295.0);
+    }
+
+    for (Done = 0; Done < Length; Done += Block)
+    {
+        Block = Length - Done;
+        if (Block > HUFF_APP_GEN_BLOCK)
+        {
+            Block = HUFF_APP_GEN_BLOCK;
+        }
+
+        HUFF_APP_GenRngFill(&Rng, Rand, sizeof(Rand) / sizeof(Rand[0]));
+
+        for (j = 0; j < Block; j++)
+        {
+            Index  = (uint32)(((uint64)Rand[j] * Alias.Count) >> 32);
+            Symbol = (Rand[HUFF_APP_GEN_BLOCK + j] < Alias.Threshold[Index]) ? Index : Alias.Alias[Index];
+
+            if (Rand[2 * HUFF_APP_GEN_BLOCK + j] < RepeatThreshold && (Done + j) > 0)
+            {
+                Symbol = Previous;
+            }
+
+            Dst[Done + j] = Symbol;
+            Previous      = Symbol;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Order-0 entropy of a histogram, in thousandths of a bit per symbol         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_GenEntropyMillibits(const uint32 *Hist, size_t Length)
+{
+    double Entropy = 0;
+    double p;
+    uint32 i;
+
+    if (Length == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Hist[i] != 0)
+        {
+            p = (double)Hist[i] / Length;
+            Entropy -= p * log2(p);
+        }
+    }
+
+    return (uint32)(Entropy * 1000.0 + 0.5);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Drop the generated input and return to seed mode                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_GenUnload(void)
+{
+    HUFF_APP_GenPipeStop();
+
+    HUFF_APP_GenData.Workload.Valid = false;
+
+    if (HUFF_APP_Data.InputMode == HUFF_APP_InputMode_GEN)
+    {
+        HUFF_APP_Data.InputMode = HUFF_APP_InputMode_SEED;
+        HUFF_APP_ServiceSetBook(0, NULL);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Generate and encode an input, and select generated mode                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_GenLoad(const HUFF_APP_Generate_Payload_t *Spec)
+{
+    const HUFF_APP_Workload_t *Current;
+    HUFF_APP_Workload_t *      Workload = &HUFF_APP_GenData.Workload;
+    CFE_Status_t               status;
+    int64                      StartMicros;
+
+    status = HUFF_APP_GenCheckSpec(Spec, Spec->Pipelined ? HUFF_APP_GENPIPE_MAX_BYTES : HUFF_APP_WORKLOAD_MAX_BYTES);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_GEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid generator: Dist = %u, Alphabet = %u, Length = %lu, Params = %lu/%lu",
+                          (unsigned int)Spec->Distribution, (unsigned int)Spec->AlphabetSize,
+                          (unsigned long)Spec->Length, (unsigned long)Spec->Param1, (unsigned long)Spec->Param2);
+        return status;
+    }
+
+    /* The generated input replaces any corpus in the workload buffers */
+    HUFF_APP_CorpusUnload();
+    HUFF_APP_GenUnload();
+
+    HUFF_APP_GenData.Spec = *Spec;
+
+    if (Spec->Pipelined)
+    {
+        status  = HUFF_APP_GenPipeStart(Spec);
+        Current = HUFF_APP_GenPipeCurrent();
+    }
+    else
+    {
+        HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_GENERATE);
+        StartMicros = HUFF_APP_GetTimeMicros();
+        HUFF_APP_GenFill(Spec, HUFF_APP_WorkloadSrcBuf, Spec->Length);
+
+        status = HUFF_APP_WorkloadPrepare(Workload, HUFF_APP_WorkloadSrcBuf, Spec->Length, HUFF_APP_WorkloadEncBuf,
+                                          sizeof(HUFF_APP_WorkloadEncBuf), HUFF_APP_WorkloadIndexBuf,
+                                          HUFF_APP_WORKLOAD_INDEX_ENTRIES);
+
+        HUFF_APP_GenData.Input.Seed             = Spec->Seed;
+        HUFF_APP_GenData.Input.EntropyMillibits = HUFF_APP_GenEntropyMillibits(Workload->Hist, Workload->Length);
+        HUFF_APP_GenData.Input.GenMicros        = (uint32)(HUFF_APP_GetTimeMicros() - StartMicros);
+        HUFF_APP_GenData.Input.WaitMicros       = 0;
+        HUFF_APP_TRACE_END(HUFF_APP_TRACE_GENERATE);
+
+        Current = Workload;
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_GEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to encode generated input, RC = 0x%08lX", (unsigned long)status);
+        return status;
+    }
+
+    HUFF_APP_Data.InputMode = HUFF_APP_InputMode_GEN;
+    HUFF_APP_ServiceSetBook(0, &Current->Book);
+
+    CFE_EVS_SendEvent(HUFF_APP_GEN_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Generated %lu symbols, dist %u, alphabet %u, entropy %lu mbit/sym, %lu encoded bytes%s",
+                      (unsigned long)Spec->Length, (unsigned int)Spec->Distribution, (unsigned int)Spec->AlphabetSize,
+                      (unsigned long)HUFF_APP_GenEntropyMillibits(Current->Hist, Current->Length),
+                      (unsigned long)Current->EncodedBytes, Spec->Pipelined ? ", pipelined" : "");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Time the decoding of the generated input and report it with its entropy    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_GenRun(void)
+{
+    const HUFF_APP_Workload_t *Workload = &HUFF_APP_GenData.Workload;
+    HUFF_APP_GenInput_t        Input    = HUFF_APP_GenData.Input;
+    HUFF_APP_DecodeResult_t    Result;
+    HUFF_APP_Report_t          Report;
+    int64                      StartMicros;
+    uint64                     EncodedBits;
+
+    if (HUFF_APP_GenData.Spec.Pipelined)
+    {
+        Workload = HUFF_APP_GenPipeNext(&Input);
+        if (Workload == NULL)
+        {
+            CFE_ES_WriteToSysLog("HUFF App: Generated input not ready");
+            return CFE_STATUS_INCORRECT_STATE;
+        }
+
+        /* Decode requests for book 0 follow the input of the last run */
+        HUFF_APP_ServiceSetBook(0, &Workload->Book);
+    }
+
+    if (!Workload->Valid)
+    {
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+    HUFF_APP_WorkloadMeasure(Workload, Workload->Length, HUFF_APP_WorkloadOutBuf, &Result);
+
+    if (Result.Status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: Generated input decode failed: 0x%08lx", (unsigned long)Result.Status);
+    }
+
+    EncodedBits = HUFF_APP_CodecEncodedBits(&Workload->Book, Workload->Hist);
+
+    HUFF_APP_ReportInit(&Report, "$HUGN");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_GenData.Spec.Distribution);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_GenData.Spec.AlphabetSize);
+    HUFF_APP_ReportAddU32(&Report, Workload->Length);
+    HUFF_APP_ReportAddU32(&Report, Input.EntropyMillibits);
+    HUFF_APP_ReportAddU32(&Report, (uint32)((EncodedBits * 1000) / Workload->Length));
+    HUFF_APP_ReportAddU32(&Report, Result.Iterations);
+    HUFF_APP_ReportAddU32(&Report, Result.DurationMicros);
+    HUFF_APP_ReportAddHexU32(&Report, Result.Status);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultKiloBytesPerSec(&Result));
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultPicosPerSymbol(&Result));
+
+    /* Input generation, outside of the timed decode */
+    HUFF_APP_ReportAddHexU32(&Report, Input.Seed);
+    HUFF_APP_ReportAddU32(&Report, Input.GenMicros);
+    HUFF_APP_ReportAddU32(&Report, Input.WaitMicros);
+    HUFF_APP_ReportSend(&Report);
+
+    return Result.Status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Encoded generated input, for the commands that decode it in other ways     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_Workload_t *HUFF_APP_GenWorkload(void)
+{
+    if (HUFF_APP_GenData.Spec.Pipelined)
+    {
+        return HUFF_APP_GenPipeCurrent();
+    }
+
+    return &HUFF_APP_GenData.Workload;
+}
@@ -0,0 +1,66 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App synthetic input generator
+ */
+
+#ifndef HUFF_APP_GEN_H
+#define HUFF_APP_GEN_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_workload.h"
+
+/* Independent xoshiro128** streams advanced side by side */
+#define HUFF_APP_GEN_LANES 4
+
+typedef struct
+{
+    uint32 s0[HUFF_APP_GEN_LANES];
+    uint32 s1[HUFF_APP_GEN_LANES];
+    uint32 s2[HUFF_APP_GEN_LANES];
+    uint32 s3[HUFF_APP_GEN_LANES];
+} HUFF_APP_GenRng_t;
+
+/*
+** One generated input, as reported with its decode
+*/
+typedef struct
+{
+    uint32 Seed;             /* Generator seed of the input */
+    uint32 EntropyMillibits; /* Order-0 entropy of the input */
+    uint32 GenMicros;        /* Time spent generating and encoding it */
+    uint32 WaitMicros;       /* Time the run waited for it to be ready */
+} HUFF_APP_GenInput_t;
+
+void         HUFF_APP_GenRngSeed(HUFF_APP_GenRng_t *Rng, uint32 Seed);
+void         HUFF_APP_GenRngFill(HUFF_APP_GenRng_t *Rng, uint32 *Out, size_t Count);
+CFE_Status_t HUFF_APP_GenCheckSpec(const HUFF_APP_Generate_Payload_t *Spec, size_t MaxLength);
+void         HUFF_APP_GenFill(const HUFF_APP_Generate_Payload_t *Spec, uint8 *Dst, size_t Length);
+uint32       HUFF_APP_GenEntropyMillibits(const uint32 *Hist, size_t Length);
+void         HUFF_APP_GenUnload(void);
+CFE_Status_t HUFF_APP_GenLoad(const HUFF_APP_Generate_Payload_t *Spec);
+CFE_Status_t HUFF_APP_GenRun(void);
+
+const HUFF_APP_Workload_t *HUFF_APP_GenWorkload(void);
+
+#endif /* HUFF_APP_GEN_H */
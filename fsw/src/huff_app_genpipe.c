@@ -0,0 +1,322 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App pipelined input
+ *   generation.
+ *
+ *   With a pipelined generator every scheduled run decodes a new input,
+ *   generated with the seed following the one of the previous input. A
+ *   generator child task fills one of two buffers while the executor
+ *   decodes the other, so sustained throughput is limited by the decode
+ *   alone. Buffers change hands through a per-buffer state flag:
+ *
+ *   - FREE:  the generator task may fill it, then stores READY (release)
+ *   - READY: filled; the executor takes it on its next run (acquire)
+ *   - OWNED: held by the executor, being decoded or stopped
+ *
+ *   The executor frees the buffer of the previous run and gives the kick
+ *   semaphore when it takes the next one. Only the executor stops or
+ *   restarts the pipeline, and waits for the generator task to be idle
+ *   first.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdatomic.h>
+
+#include "huff_app.h"
+#include "huff_app_gen.h"
+#include "huff_app_genpipe.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+/* Worst case encoded size of a pipeline input */
+#define HUFF_APP_GENPIPE_ENC_BYTES \
+    ((HUFF_APP_GENPIPE_MAX_BYTES / 8) * HUFF_APP_CODEC_MAX_CODE_LEN + HUFF_APP_CODEC_MAX_CODE_LEN)
+
+/* Entries of the block index of the largest pipeline input */
+#define HUFF_APP_GENPIPE_INDEX_ENTRIES \
+    ((HUFF_APP_GENPIPE_MAX_BYTES + HUFF_APP_WORKLOAD_BLOCK_SYMBOLS - 1) / HUFF_APP_WORKLOAD_BLOCK_SYMBOLS)
+
+#define HUFF_APP_GENPIPE_BANKS 2
+
+enum
+{
+    HUFF_APP_GENPIPE_FREE  = 0,
+    HUFF_APP_GENPIPE_READY = 1,
+    HUFF_APP_GENPIPE_OWNED = 2
+};
+
+typedef struct
+{
+    atomic_int          State;
+    HUFF_APP_GenInput_t Input;
+    HUFF_APP_Workload_t Workload;
+
+    uint8  Src[HUFF_APP_GENPIPE_MAX_BYTES];
+    uint8  Enc[HUFF_APP_GENPIPE_ENC_BYTES];
+    uint32 Index[HUFF_APP_GENPIPE_INDEX_ENTRIES];
+} HUFF_APP_GenPipeBank_t;
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    osal_id_t       KickSem; /* Given when a buffer becomes FREE */
+    bool            Created;
+
+    /* Only written while the generator task is idle */
+    HUFF_APP_Generate_Payload_t Spec;
+    uint32                      NextSeed;
+
+    atomic_bool Busy; /* Generator task is looking at or filling the buffers */
+
+    /* Executor only */
+    bool   Active;
+    bool   Fresh; /* Current buffer not yet decoded by a run */
+    uint32 Current;
+
+    HUFF_APP_GenPipeBank_t Bank[HUFF_APP_GENPIPE_BANKS];
+} HUFF_APP_GenPipeData_t;
+
+static HUFF_APP_GenPipeData_t HUFF_APP_GenPipeData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Generate and encode the input of the next seed into a buffer               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_GenPipeFill(HUFF_APP_GenPipeBank_t *Bank)
+{
+    HUFF_APP_Generate_Payload_t Spec = HUFF_APP_GenPipeData.Spec;
+    int64                       StartMicros;
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_GENERATE);
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    Spec.Seed = HUFF_APP_GenPipeData.NextSeed++;
+    HUFF_APP_GenFill(&Spec, Bank->Src, Spec.Length);
+
+    /* The spec was checked against the buffer size, a failure leaves the workload invalid */
+    HUFF_APP_WorkloadPrepare(&Bank->Workload, Bank->Src, Spec.Length, Bank->Enc, sizeof(Bank->Enc), Bank->Index,
+                             HUFF_APP_GENPIPE_INDEX_ENTRIES);
+
+    Bank->Input.Seed             = Spec.Seed;
+    Bank->Input.EntropyMillibits = HUFF_APP_GenEntropyMillibits(Bank->Workload.Hist, Bank->Workload.Length);
+    Bank->Input.GenMicros        = (uint32)(HUFF_APP_GetTimeMicros() - StartMicros);
+    Bank->Input.WaitMicros       = 0;
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_GENERATE);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Generator child task entry point                                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_GenPipeTaskMain(void)
+{
+    HUFF_APP_GenPipeBank_t *Bank;
+    uint32                  i;
+
+    HUFF_APP_TraceAttach("HUFF_GENPIPE");
+
+    while (OS_BinSemTake(HUFF_APP_GenPipeData.KickSem) == OS_SUCCESS)
+    {
+        /* Sequentially consistent with the stores of HUFF_APP_GenPipeStop() */
+        atomic_store(&HUFF_APP_GenPipeData.Busy, true);
+
+        for (i = 0; i < HUFF_APP_GENPIPE_BANKS; i++)
+        {
+            Bank = &HUFF_APP_GenPipeData.Bank[i];
+            if (atomic_load(&Bank->State) == HUFF_APP_GENPIPE_FREE)
+            {
+                HUFF_APP_GenPipeFill(Bank);
+                atomic_store_explicit(&Bank->State, HUFF_APP_GENPIPE_READY, memory_order_release);
+            }
+        }
+
+        atomic_store(&HUFF_APP_GenPipeData.Busy, false);
+    }
+
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Take back every buffer and wait for the generator task to be idle          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_GenPipeStop(void)
+{
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_GENPIPE_BANKS; i++)
+    {
+        atomic_store(&HUFF_APP_GenPipeData.Bank[i].State, HUFF_APP_GENPIPE_OWNED);
+    }
+
+    /* A fill that saw a FREE buffer before the stores above is still running */
+    while (atomic_load(&HUFF_APP_GenPipeData.Busy))
+    {
+        OS_TaskDelay(1);
+    }
+
+    /* That fill marked its buffer READY */
+    for (i = 0; i < HUFF_APP_GENPIPE_BANKS; i++)
+    {
+        atomic_store(&HUFF_APP_GenPipeData.Bank[i].State, HUFF_APP_GENPIPE_OWNED);
+    }
+
+    HUFF_APP_GenPipeData.Active = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Start a pipeline: the first input is generated now, the next one in the    */
+/* background                                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_GenPipeStart(const HUFF_APP_Generate_Payload_t *Spec)
+{
+    CFE_Status_t status;
+    uint32       i;
+
+    if (Spec->Length > HUFF_APP_GENPIPE_MAX_BYTES)
+    {
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    if (!HUFF_APP_GenPipeData.Created)
+    {
+        for (i = 0; i < HUFF_APP_GENPIPE_BANKS; i++)
+        {
+            atomic_init(&HUFF_APP_GenPipeData.Bank[i].State, HUFF_APP_GENPIPE_OWNED);
+        }
+        atomic_init(&HUFF_APP_GenPipeData.Busy, false);
+
+        if (OS_BinSemCreate(&HUFF_APP_GenPipeData.KickSem, "HUFF_GP_SEM", 0, 0) != OS_SUCCESS)
+        {
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+
+        status = CFE_ES_CreateChildTask(&HUFF_APP_GenPipeData.TaskId, "HUFF_GENPIPE", HUFF_APP_GenPipeTaskMain,
+                                        CFE_ES_TASK_STACK_ALLOCATE, HUFF_APP_GENPIPE_STACK_SIZE,
+                                        HUFF_APP_GENPIPE_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            OS_BinSemDelete(HUFF_APP_GenPipeData.KickSem);
+            return status;
+        }
+
+        HUFF_APP_GenPipeData.Created = true;
+    }
+
+    HUFF_APP_GenPipeStop();
+
+    HUFF_APP_GenPipeData.Spec     = *Spec;
+    HUFF_APP_GenPipeData.NextSeed = Spec->Seed;
+
+    HUFF_APP_GenPipeFill(&HUFF_APP_GenPipeData.Bank[0]);
+    if (!HUFF_APP_GenPipeData.Bank[0].Workload.Valid)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    HUFF_APP_GenPipeData.Current = 0;
+    HUFF_APP_GenPipeData.Fresh   = true;
+    HUFF_APP_GenPipeData.Active  = true;
+
+    for (i = 1; i < HUFF_APP_GENPIPE_BANKS; i++)
+    {
+        atomic_store(&HUFF_APP_GenPipeData.Bank[i].State, HUFF_APP_GENPIPE_FREE);
+    }
+    OS_BinSemGive(HUFF_APP_GenPipeData.KickSem);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Input of the next run. Frees the buffer of the previous run and waits for  */
+/* the following one to be ready. Returns NULL when stopped or on timeout.    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_Workload_t *HUFF_APP_GenPipeNext(HUFF_APP_GenInput_t *Input)
+{
+    HUFF_APP_GenPipeBank_t *Bank;
+    uint32                  Next;
+    int64                   StartMicros;
+    int64                   WaitMicros = 0;
+
+    if (!HUFF_APP_GenPipeData.Active)
+    {
+        return NULL;
+    }
+
+    if (!HUFF_APP_GenPipeData.Fresh)
+    {
+        Next = (HUFF_APP_GenPipeData.Current + 1) % HUFF_APP_GENPIPE_BANKS;
+        Bank = &HUFF_APP_GenPipeData.Bank[Next];
+
+        StartMicros = HUFF_APP_GetTimeMicros();
+        while (atomic_load_explicit(&Bank->State, memory_order_acquire) != HUFF_APP_GENPIPE_READY)
+        {
+            WaitMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+            if (WaitMicros >= (int64)HUFF_APP_GENPIPE_WAIT_TIMEOUT * 1000)
+            {
+                return NULL;
+            }
+            OS_TaskDelay(1);
+        }
+
+        atomic_store_explicit(&Bank->State, HUFF_APP_GENPIPE_OWNED, memory_order_relaxed);
+
+        /* The previous input is refilled while this one is decoded */
+        atomic_store_explicit(&HUFF_APP_GenPipeData.Bank[HUFF_APP_GenPipeData.Current].State,
+                              HUFF_APP_GENPIPE_FREE, memory_order_release);
+        OS_BinSemGive(HUFF_APP_GenPipeData.KickSem);
+
+        HUFF_APP_GenPipeData.Current = Next;
+    }
+
+    HUFF_APP_GenPipeData.Fresh = false;
+
+    Bank              = &HUFF_APP_GenPipeData.Bank[HUFF_APP_GenPipeData.Current];
+    *Input            = Bank->Input;
+    Input->WaitMicros = (uint32)WaitMicros;
+
+    return &Bank->Workload;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Input of the last run, for the commands that decode it in other ways       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_Workload_t *HUFF_APP_GenPipeCurrent(void)
+{
+    if (!HUFF_APP_GenPipeData.Active)
+    {
+        return NULL;
+    }
+
+    return &HUFF_APP_GenPipeData.Bank[HUFF_APP_GenPipeData.Current].Workload;
+}
@@ -0,0 +1,39 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App pipelined input generation
+ */
+
+#ifndef HUFF_APP_GENPIPE_H
+#define HUFF_APP_GENPIPE_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_gen.h"
+#include "huff_app_workload.h"
+
+CFE_Status_t               HUFF_APP_GenPipeStart(const HUFF_APP_Generate_Payload_t *Spec);
+void                       HUFF_APP_GenPipeStop(void);
+const HUFF_APP_Workload_t *HUFF_APP_GenPipeNext(HUFF_APP_GenInput_t *Input);
+const HUFF_APP_Workload_t *HUFF_APP_GenPipeCurrent(void);
+
+#endif /* HUFF_APP_GENPIPE_H */
@@ -0,0 +1,281 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App background interference generator.
+ *
+ *   Interference runs in low priority child tasks, each working on its own
+ *   slice of a static buffer, until HUFF_APP_InterfStop() is called.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdio.h>
+
+#include "huff_app.h"
+#include "huff_app_interf.h"
+
+/* Number of work units between two checks of the stop flag */
+#define HUFF_APP_INTERF_CHECK_INTERVAL 1024
+
+/* One pointer chasing node per cache line */
+#define HUFF_APP_INTERF_LINE_SIZE 64
+
+typedef struct
+{
+    CFE_ES_TaskId_t   TaskId;
+    volatile bool     Running;
+    volatile uint32   WorkUnits;
+} HUFF_APP_InterfTask_t;
+
+typedef struct
+{
+    volatile bool              Active;
+    HUFF_APP_InterfKind_Enum_t Kind;
+    uint8                      NumTasks;
+    uint8                      StartIndex;
+    osal_id_t                  StartSem;
+    HUFF_APP_InterfTask_t      Task[HUFF_APP_INTERF_MAX_TASKS];
+} HUFF_APP_InterfData_t;
+
+static HUFF_APP_InterfData_t HUFF_APP_InterfData;
+
+static uint8 HUFF_APP_InterfBuffer[HUFF_APP_INTERF_MAX_TASKS][HUFF_APP_INTERF_BUFFER_SIZE]
+    __attribute__((aligned(HUFF_APP_INTERF_LINE_SIZE)));
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Streaming read-modify-write over the whole buffer                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_InterfStream(HUFF_APP_InterfTask_t *Task, uint8 *Buffer)
+{
+    uint64 *Words    = (uint64 *)Buffer;
+    size_t  NumWords = HUFF_APP_INTERF_BUFFER_SIZE / sizeof(uint64);
+    size_t  i;
+
+    while (HUFF_APP_InterfData.Active)
+    {
+        for (i = 0; i < NumWords; i++)
+        {
+            Words[i] += i;
+        }
+        Task->WorkUnits++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Random pointer chasing, one dependent load per cache line                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_InterfChase(HUFF_APP_InterfTask_t *Task, uint8 *Buffer)
+{
+    size_t  NumLines = HUFF_APP_INTERF_BUFFER_SIZE / HUFF_APP_INTERF_LINE_SIZE;
+    size_t  i;
+    size_t  j;
+    size_t  Tmp;
+    size_t  Line;
+    uint32  Rand = 0x2545F491;
+    uint32  Count;
+
+    /* Each line starts with the index of the next line; build a single random cycle (Sattolo) */
+    for (i = 0; i < NumLines; i++)
+    {
+        *(size_t *)&Buffer[i * HUFF_APP_INTERF_LINE_SIZE] = i;
+    }
+    for (i = NumLines - 1; i > 0; i--)
+    {
+        Rand ^= Rand << 13;
+        Rand ^= Rand >> 17;
+        Rand ^= Rand << 5;
+        j = Rand % i;
+
+        Tmp                                              = *(size_t *)&Buffer[i * HUFF_APP_INTERF_LINE_SIZE];
+        *(size_t *)&Buffer[i * HUFF_APP_INTERF_LINE_SIZE] = *(size_t *)&Buffer[j * HUFF_APP_INTERF_LINE_SIZE];
+        *(size_t *)&Buffer[j * HUFF_APP_INTERF_LINE_SIZE] = Tmp;
+    }
+
+    Line = 0;
+    while (HUFF_APP_InterfData.Active)
+    {
+        for (Count = 0; Count < HUFF_APP_INTERF_CHECK_INTERVAL; Count++)
+        {
+            Line = *(volatile size_t *)&Buffer[Line * HUFF_APP_INTERF_LINE_SIZE];
+        }
+        Task->WorkUnits++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Register-only busy loop                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_InterfSpin(HUFF_APP_InterfTask_t *Task)
+{
+    volatile uint32 Sink;
+    uint32          Acc = 1;
+    uint32          Count;
+
+    while (HUFF_APP_InterfData.Active)
+    {
+        for (Count = 0; Count < HUFF_APP_INTERF_CHECK_INTERVAL; Count++)
+        {
+            Acc = Acc * 1664525 + 1013904223;
+        }
+        Sink = Acc;
+        Task->WorkUnits++;
+    }
+    (void)Sink;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Interference child task entry point                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_InterfTaskMain(void)
+{
+    uint8                  Index;
+    HUFF_APP_InterfTask_t *Task;
+
+    /* Claim the slot index published by HUFF_APP_InterfStart() */
+    Index = HUFF_APP_InterfData.StartIndex;
+    Task  = &HUFF_APP_InterfData.Task[Index];
+
+    Task->Running   = true;
+    Task->WorkUnits = 0;
+    OS_BinSemGive(HUFF_APP_InterfData.StartSem);
+
+    switch (HUFF_APP_InterfData.Kind)
+    {
+        case HUFF_APP_InterfKind_STREAM:
+            HUFF_APP_InterfStream(Task, HUFF_APP_InterfBuffer[Index]);
+            break;
+
+        case HUFF_APP_InterfKind_CHASE:
+            HUFF_APP_InterfChase(Task, HUFF_APP_InterfBuffer[Index]);
+            break;
+
+        default:
+            HUFF_APP_InterfSpin(Task);
+            break;
+    }
+
+    Task->Running = false;
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Start the interference tasks                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_InterfStart(HUFF_APP_InterfKind_Enum_t Kind, uint8 NumTasks)
+{
+    CFE_Status_t status = CFE_SUCCESS;
+    int32        OsStatus;
+    char         TaskName[OS_MAX_API_NAME];
+    uint8        i;
+
+    if (HUFF_APP_InterfData.NumTasks != 0)
+    {
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    if (!OS_ObjectIdDefined(HUFF_APP_InterfData.StartSem))
+    {
+        OsStatus = OS_BinSemCreate(&HUFF_APP_InterfData.StartSem, "HUFF_IF_SEM", OS_SEM_EMPTY, 0);
+        if (OsStatus != OS_SUCCESS)
+        {
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+    }
+
+    HUFF_APP_InterfData.Kind   = Kind;
+    HUFF_APP_InterfData.Active = true;
+
+    for (i = 0; i < NumTasks; i++)
+    {
+        snprintf(TaskName, sizeof(TaskName), "HUFF_IF_%u", (unsigned int)i);
+
+        HUFF_APP_InterfData.StartIndex = i;
+        status = CFE_ES_CreateChildTask(&HUFF_APP_InterfData.Task[i].TaskId, TaskName, HUFF_APP_InterfTaskMain,
+                                        CFE_ES_TASK_STACK_ALLOCATE, HUFF_APP_INTERF_STACK_SIZE,
+                                        HUFF_APP_INTERF_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        /* Wait for the task to take its slot before publishing the next index */
+        OS_BinSemTake(HUFF_APP_InterfData.StartSem);
+        HUFF_APP_InterfData.NumTasks++;
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        OS_TaskDelay(HUFF_APP_INTERF_WARMUP_MS);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Stop the interference tasks and wait for them to exit                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_InterfStop(void)
+{
+    uint32 Waited = 0;
+    bool   AnyRunning;
+    uint8  i;
+
+    HUFF_APP_InterfData.Active = false;
+
+    do
+    {
+        AnyRunning = false;
+        for (i = 0; i < HUFF_APP_InterfData.NumTasks; i++)
+        {
+            AnyRunning |= HUFF_APP_InterfData.Task[i].Running;
+        }
+
+        if (AnyRunning)
+        {
+            OS_TaskDelay(10);
+            Waited += 10;
+        }
+    } while (AnyRunning && Waited < HUFF_APP_INTERF_STOP_TIMEOUT);
+
+    for (i = 0; i < HUFF_APP_InterfData.NumTasks; i++)
+    {
+        if (HUFF_APP_InterfData.Task[i].Running)
+        {
+            CFE_ES_WriteToSysLog("HUFF App: Interference task %u did not exit, deleting it\n", (unsigned int)i);
+            CFE_ES_DeleteChildTask(HUFF_APP_InterfData.Task[i].TaskId);
+            HUFF_APP_InterfData.Task[i].Running = false;
+        }
+    }
+
+    HUFF_APP_InterfData.NumTasks = 0;
+}
@@ -0,0 +1,35 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App background interference generator
+ */
+
+#ifndef HUFF_APP_INTERF_H
+#define HUFF_APP_INTERF_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+
+CFE_Status_t HUFF_APP_InterfStart(HUFF_APP_InterfKind_Enum_t Kind, uint8 NumTasks);
+void         HUFF_APP_InterfStop(void);
+
+#endif /* HUFF_APP_INTERF_H */
@@ -0,0 +1,746 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App parallel block decode.
+ *
+ *   The block index of a workload gives the bit offset of every
+ *   HUFF_APP_WORKLOAD_BLOCK_SYMBOLS-th symbol, so blocks can be decoded at
+ *   the same time by several workers. The task running the command (the
+ *   benchmark executor) is worker 0 and child tasks, created on first use,
+ *   are the others. Every worker writes
+ *   straight into the final offsets of the output buffer: nothing is copied
+ *   or merged afterwards.
+ *
+ *   With the static schedule each worker decodes one contiguous range of
+ *   blocks. With the work-stealing schedule the blocks are grouped in chunks
+ *   seeded into one Chase-Lev deque per worker (same ranges as the static
+ *   split); the owner takes chunks from the bottom of its deque and, once it
+ *   is empty, steals from the top of the others with C11 atomics, so that
+ *   chunks of uneven decode cost do not leave workers idle.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdio.h>
+
+#include "huff_app.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_pardec.h"
+#include "huff_app_runstat.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+#define HUFF_APP_PARDEC_STEAL_SUPPORTED
+#endif
+
+/* Chunks of the largest workload, all of which may be seeded into one deque */
+#define HUFF_APP_PARDEC_MAX_CHUNKS \
+    ((HUFF_APP_WORKLOAD_INDEX_ENTRIES + HUFF_APP_PARDEC_CHUNK_BLOCKS - 1) / HUFF_APP_PARDEC_CHUNK_BLOCKS)
+
+/* Keeps the deque indices of different workers in different cache lines */
+#define HUFF_APP_PARDEC_LINE_SIZE 64
+
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+
+#define HUFF_APP_PARDEC_EMPTY (-1) /* No chunk left in the deque */
+#define HUFF_APP_PARDEC_ABORT (-2) /* Lost a race for the last chunks, the deque may not be empty */
+
+/*
+** Chase-Lev deque of chunk numbers. Chunks are only pushed before the
+** workers are released, so the array never grows.
+*/
+typedef struct
+{
+    atomic_int Top __attribute__((aligned(HUFF_APP_PARDEC_LINE_SIZE)));
+    atomic_int Bottom __attribute__((aligned(HUFF_APP_PARDEC_LINE_SIZE)));
+    int32      Chunk[HUFF_APP_PARDEC_MAX_CHUNKS];
+} HUFF_APP_ParDecDeque_t;
+
+static HUFF_APP_ParDecDeque_t HUFF_APP_ParDecDeque[HUFF_APP_PARDEC_MAX_WORKERS];
+
+#endif
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    osal_id_t       GoSem;
+    int32           Status;
+
+    /* Counters, updated by the worker while a job runs */
+    uint32 Chunks;
+    uint32 Steals;
+    uint64 BusyMicros;
+    uint64 JobMicros; /* Elapsed time of the jobs the worker took part in */
+} HUFF_APP_ParDecWorker_t;
+
+typedef struct
+{
+    /* Current job, published before the workers are released */
+    const HUFF_APP_Workload_t * Workload;
+    uint8 *                     Out;
+    uint8                       NumWorkers;
+    HUFF_APP_ParDecSched_Enum_t Sched;
+
+    uint32 Jobs;
+
+    uint8                   NumTasks; /* Worker tasks created, in slots 1 and up */
+    uint8                   StartIndex;
+    osal_id_t               StartSem;
+    osal_id_t               DoneSem;
+    HUFF_APP_ParDecWorker_t Worker[HUFF_APP_PARDEC_MAX_WORKERS];
+} HUFF_APP_ParDecData_t;
+
+static HUFF_APP_ParDecData_t HUFF_APP_ParDecData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode blocks FirstBlock to EndBlock - 1 into their place in the output    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_ParDecBlocks(size_t FirstBlock, size_t EndBlock)
+{
+    const HUFF_APP_Workload_t *Workload = HUFF_APP_ParDecData.Workload;
+    size_t                     FirstSymbol;
+    size_t                     EndSymbol;
+
+    if (FirstBlock >= EndBlock)
+    {
+        return CFE_SUCCESS;
+    }
+
+    FirstSymbol = FirstBlock * HUFF_APP_WORKLOAD_BLOCK_SYMBOLS;
+    EndSymbol   = EndBlock * HUFF_APP_WORKLOAD_BLOCK_SYMBOLS;
+    if (EndSymbol > Workload->Length)
+    {
+        EndSymbol = Workload->Length;
+    }
+
+    return HUFF_APP_CodecDecodeAt(&Workload->Table, Workload->Enc, Workload->EncodedBytes,
+                                  Workload->Index[FirstBlock], &HUFF_APP_ParDecData.Out[FirstSymbol],
+                                  EndSymbol - FirstSymbol);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Static schedule: decode the contiguous range of blocks of one worker       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_ParDecRange(uint8 Index)
+{
+    size_t Entries = HUFF_APP_ParDecData.Workload->IndexEntries;
+
+    HUFF_APP_ParDecData.Worker[Index].Chunks++;
+
+    return HUFF_APP_ParDecBlocks((Entries * Index) / HUFF_APP_ParDecData.NumWorkers,
+                                 (Entries * (Index + 1)) / HUFF_APP_ParDecData.NumWorkers);
+}
+
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Deque operations (Le, Pop, Cohen and Zappa Nardelli, PPoPP 2013)           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ParDecPush(HUFF_APP_ParDecDeque_t *Deque, int32 Chunk)
+{
+    int Bottom = atomic_load_explicit(&Deque->Bottom, memory_order_relaxed);
+
+    Deque->Chunk[Bottom] = Chunk;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&Deque->Bottom, Bottom + 1, memory_order_relaxed);
+}
+
+/* Owner only */
+static int32 HUFF_APP_ParDecTake(HUFF_APP_ParDecDeque_t *Deque)
+{
+    int   Bottom = atomic_load_explicit(&Deque->Bottom, memory_order_relaxed) - 1;
+    int   Top;
+    int32 Chunk = HUFF_APP_PARDEC_EMPTY;
+
+    atomic_store_explicit(&Deque->Bottom, Bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    Top = atomic_load_explicit(&Deque->Top, memory_order_relaxed);
+
+    if (Top <= Bottom)
+    {
+        Chunk = Deque->Chunk[Bottom];
+        if (Top == Bottom)
+        {
+            /* Last chunk: race the thieves for it */
+            if (!atomic_compare_exchange_strong_explicit(&Deque->Top, &Top, Top + 1, memory_order_seq_cst,
+                                                         memory_order_relaxed))
+            {
+                Chunk = HUFF_APP_PARDEC_EMPTY;
+            }
+            atomic_store_explicit(&Deque->Bottom, Bottom + 1, memory_order_relaxed);
+        }
+    }
+    else
+    {
+        atomic_store_explicit(&Deque->Bottom, Bottom + 1, memory_order_relaxed);
+    }
+
+    return Chunk;
+}
+
+/* Any other worker */
+static int32 HUFF_APP_ParDecSteal(HUFF_APP_ParDecDeque_t *Deque)
+{
+    int   Top = atomic_load_explicit(&Deque->Top, memory_order_acquire);
+    int   Bottom;
+    int32 Chunk;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    Bottom = atomic_load_explicit(&Deque->Bottom, memory_order_acquire);
+
+    if (Top >= Bottom)
+    {
+        return HUFF_APP_PARDEC_EMPTY;
+    }
+
+    Chunk = Deque->Chunk[Top];
+    if (!atomic_compare_exchange_strong_explicit(&Deque->Top, &Top, Top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed))
+    {
+        return HUFF_APP_PARDEC_ABORT;
+    }
+
+    return Chunk;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Split the chunks in one contiguous range per worker deque. Chunks are      */
+/* pushed last first, so the owner takes them in increasing order and the     */
+/* thieves take the far end of the range.                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ParDecSeed(void)
+{
+    size_t NumChunks;
+    size_t First;
+    size_t End;
+    uint8  i;
+
+    NumChunks = (HUFF_APP_ParDecData.Workload->IndexEntries + HUFF_APP_PARDEC_CHUNK_BLOCKS - 1) /
+                HUFF_APP_PARDEC_CHUNK_BLOCKS;
+
+    for (i = 0; i < HUFF_APP_ParDecData.NumWorkers; i++)
+    {
+        atomic_store_explicit(&HUFF_APP_ParDecDeque[i].Top, 0, memory_order_relaxed);
+        atomic_store_explicit(&HUFF_APP_ParDecDeque[i].Bottom, 0, memory_order_relaxed);
+
+        First = (NumChunks * i) / HUFF_APP_ParDecData.NumWorkers;
+        End   = (NumChunks * (i + 1)) / HUFF_APP_ParDecData.NumWorkers;
+        while (End > First)
+        {
+            End--;
+            HUFF_APP_ParDecPush(&HUFF_APP_ParDecDeque[i], (int32)End);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Work-stealing schedule: drain the own deque, then steal until every deque  */
+/* is empty. Nothing is pushed while a job runs, so empty deques stay empty.  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_ParDecStealLoop(uint8 Index)
+{
+    HUFF_APP_ParDecWorker_t *Worker = &HUFF_APP_ParDecData.Worker[Index];
+    uint8                    NumWorkers = HUFF_APP_ParDecData.NumWorkers;
+    int32                    status     = CFE_SUCCESS;
+    int32                    ChunkStatus;
+    int32                    Chunk;
+    bool                     Retry;
+    uint8                    n;
+
+    while (true)
+    {
+        Chunk = HUFF_APP_ParDecTake(&HUFF_APP_ParDecDeque[Index]);
+        if (Chunk < 0)
+        {
+            do
+            {
+                Retry = false;
+                for (n = 1; n < NumWorkers && Chunk < 0; n++)
+                {
+                    Chunk = HUFF_APP_ParDecSteal(&HUFF_APP_ParDecDeque[(Index + n) % NumWorkers]);
+                    Retry |= (Chunk == HUFF_APP_PARDEC_ABORT);
+                }
+            } while (Chunk < 0 && Retry);
+
+            if (Chunk < 0)
+            {
+                break;
+            }
+            Worker->Steals++;
+        }
+
+        ChunkStatus = HUFF_APP_ParDecBlocks((size_t)Chunk * HUFF_APP_PARDEC_CHUNK_BLOCKS,
+                                            ((size_t)Chunk + 1) * HUFF_APP_PARDEC_CHUNK_BLOCKS);
+        Worker->Chunks++;
+
+        if (ChunkStatus != CFE_SUCCESS && status == CFE_SUCCESS)
+        {
+            status = ChunkStatus;
+        }
+    }
+
+    return status;
+}
+
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Share of one worker in the current job                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_ParDecWork(uint8 Index)
+{
+    int64 StartMicros = HUFF_APP_GetTimeMicros();
+    int32 status;
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DECODE);
+
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+    if (HUFF_APP_ParDecData.Sched == HUFF_APP_ParDecSched_STEAL)
+    {
+        status = HUFF_APP_ParDecStealLoop(Index);
+    }
+    else
+#endif
+    {
+        status = HUFF_APP_ParDecRange(Index);
+    }
+
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_DECODE);
+
+    HUFF_APP_ParDecData.Worker[Index].BusyMicros += HUFF_APP_GetTimeMicros() - StartMicros;
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Chunks stolen by all workers                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_ParDecSteals(void)
+{
+    uint32 Steals = 0;
+    uint8  i;
+
+    for (i = 0; i < HUFF_APP_PARDEC_MAX_WORKERS; i++)
+    {
+        Steals += HUFF_APP_ParDecData.Worker[i].Steals;
+    }
+
+    return Steals;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Worker child task entry point                                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ParDecTaskMain(void)
+{
+    uint8                    Index;
+    HUFF_APP_ParDecWorker_t *Worker;
+    char                     Name[OS_MAX_API_NAME];
+
+    /* Claim the slot index published by HUFF_APP_ParDecStart() */
+    Index  = HUFF_APP_ParDecData.StartIndex;
+    Worker = &HUFF_APP_ParDecData.Worker[Index];
+    OS_BinSemGive(HUFF_APP_ParDecData.StartSem);
+
+    snprintf(Name, sizeof(Name), "HUFF_PD_%u", (unsigned int)Index);
+    HUFF_APP_TraceAttach(Name);
+
+    while (OS_BinSemTake(Worker->GoSem) == OS_SUCCESS)
+    {
+        Worker->Status = HUFF_APP_ParDecWork(Index);
+        OS_CountSemGive(HUFF_APP_ParDecData.DoneSem);
+    }
+
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Create the worker tasks needed for NumWorkers decoders                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ParDecStart(uint8 NumWorkers)
+{
+    CFE_Status_t status = CFE_SUCCESS;
+    int32        OsStatus;
+    char         Name[OS_MAX_API_NAME];
+    uint8        i;
+
+    if (!OS_ObjectIdDefined(HUFF_APP_ParDecData.StartSem))
+    {
+        OsStatus = OS_BinSemCreate(&HUFF_APP_ParDecData.StartSem, "HUFF_PD_SEM", OS_SEM_EMPTY, 0);
+        if (OsStatus == OS_SUCCESS)
+        {
+            OsStatus = OS_CountSemCreate(&HUFF_APP_ParDecData.DoneSem, "HUFF_PD_DONE", 0, 0);
+        }
+        if (OsStatus != OS_SUCCESS)
+        {
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+    }
+
+    for (i = 1 + HUFF_APP_ParDecData.NumTasks; i < NumWorkers; i++)
+    {
+        snprintf(Name, sizeof(Name), "HUFF_PD_GO_%u", (unsigned int)i);
+        OsStatus = OS_BinSemCreate(&HUFF_APP_ParDecData.Worker[i].GoSem, Name, OS_SEM_EMPTY, 0);
+        if (OsStatus != OS_SUCCESS)
+        {
+            status = CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+            break;
+        }
+
+        snprintf(Name, sizeof(Name), "HUFF_PD_%u", (unsigned int)i);
+        HUFF_APP_ParDecData.StartIndex = i;
+        status = CFE_ES_CreateChildTask(&HUFF_APP_ParDecData.Worker[i].TaskId, Name, HUFF_APP_ParDecTaskMain,
+                                        CFE_ES_TASK_STACK_ALLOCATE, HUFF_APP_PARDEC_STACK_SIZE,
+                                        HUFF_APP_PARDEC_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            OS_BinSemDelete(HUFF_APP_ParDecData.Worker[i].GoSem);
+            break;
+        }
+
+        /* Wait for the task to take its slot before publishing the next index */
+        OS_BinSemTake(HUFF_APP_ParDecData.StartSem);
+        HUFF_APP_ParDecData.NumTasks++;
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode a whole workload with NumWorkers decoders Result->Iterations times  */
+/* in one timed sample, then verify the output against the original input     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_ParDecDecode(const HUFF_APP_Workload_t *Workload, uint8 NumWorkers,
+                            HUFF_APP_ParDecSched_Enum_t Sched, uint8 *Out, HUFF_APP_DecodeResult_t *Result)
+{
+    int64  StartMicros;
+    int64  JobMicros;
+    int32  status;
+    uint32 n;
+    uint8  i;
+
+    Result->Status = CFE_SUCCESS;
+    if (Result->Iterations == 0)
+    {
+        Result->Iterations = 1;
+    }
+    if (NumWorkers > 1 + HUFF_APP_ParDecData.NumTasks)
+    {
+        NumWorkers = 1 + HUFF_APP_ParDecData.NumTasks;
+    }
+
+    HUFF_APP_ParDecData.Workload   = Workload;
+    HUFF_APP_ParDecData.Out        = Out;
+    HUFF_APP_ParDecData.NumWorkers = NumWorkers;
+    HUFF_APP_ParDecData.Sched      = Sched;
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    for (n = 0; n < Result->Iterations; n++)
+    {
+        JobMicros = HUFF_APP_GetTimeMicros();
+
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+        if (Sched == HUFF_APP_ParDecSched_STEAL)
+        {
+            HUFF_APP_ParDecSeed();
+        }
+#endif
+
+        /* The semaphores order the job and the seeded deques before the workers start */
+        for (i = 1; i < NumWorkers; i++)
+        {
+            OS_BinSemGive(HUFF_APP_ParDecData.Worker[i].GoSem);
+        }
+
+        status = HUFF_APP_ParDecWork(0);
+
+        for (i = 1; i < NumWorkers; i++)
+        {
+            OS_CountSemTake(HUFF_APP_ParDecData.DoneSem);
+        }
+
+        JobMicros = HUFF_APP_GetTimeMicros() - JobMicros;
+        for (i = 0; i < NumWorkers; i++)
+        {
+            HUFF_APP_ParDecData.Worker[i].JobMicros += JobMicros;
+        }
+        HUFF_APP_ParDecData.Jobs++;
+
+        for (i = 1; i < NumWorkers && status == CFE_SUCCESS; i++)
+        {
+            status = HUFF_APP_ParDecData.Worker[i].Status;
+        }
+
+        if (status != CFE_SUCCESS && Result->Status == CFE_SUCCESS)
+        {
+            Result->Status = status;
+        }
+    }
+
+    Result->DurationMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+    Result->Symbols        = (uint64)Workload->Length * Result->Iterations;
+    HUFF_APP_RunStatDecoded(Result->Symbols, Result->Symbols);
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_VERIFY);
+    if (Result->Status == CFE_SUCCESS && memcmp(Out, Workload->Src, Workload->Length) != 0)
+    {
+        Result->Status = CFE_STATUS_VALIDATION_FAILURE;
+    }
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_VERIFY);
+
+    return Result->Status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Fill the output with the complement of the expected symbols, so that any   */
+/* block a schedule skips fails the verification                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ParDecGuardOutput(const HUFF_APP_Workload_t *Workload, uint8 *Out)
+{
+    size_t i;
+
+    for (i = 0; i < Workload->Length; i++)
+    {
+        Out[i] = (uint8)~Workload->Src[i];
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Timed decode, with the iteration count doubled until the sample lasts at   */
+/* least the calibrated minimum sample time                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_ParDecMeasure(const HUFF_APP_Workload_t *Workload, uint8 NumWorkers,
+                                    HUFF_APP_ParDecSched_Enum_t Sched, HUFF_APP_DecodeResult_t *Result)
+{
+    uint32 Iterations = 1;
+
+    while (true)
+    {
+        /* Outside the timed region: every sample must write the whole output itself */
+        HUFF_APP_ParDecGuardOutput(Workload, HUFF_APP_WorkloadOutBuf);
+
+        Result->Iterations = Iterations;
+        if (HUFF_APP_ParDecDecode(Workload, NumWorkers, Sched, HUFF_APP_WorkloadOutBuf, Result) != CFE_SUCCESS ||
+            Result->DurationMicros >= HUFF_APP_Data.MinSampleMicros || Iterations >= HUFF_APP_CALIB_MAX_ITERATIONS)
+        {
+            break;
+        }
+
+        Iterations *= 2;
+    }
+
+    return Result->Status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Report one worker count                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ParDecReport(const HUFF_APP_Workload_t *Workload, uint8 NumWorkers,
+                                  HUFF_APP_ParDecSched_Enum_t Sched, const HUFF_APP_DecodeResult_t *Result,
+                                  uint32 BaseKiloBytesPerSec, uint32 Steals, int64 StartMicros)
+{
+    HUFF_APP_Report_t Report;
+    uint32            KiloBytesPerSec;
+    uint32            SpeedupPermille = 0;
+
+    KiloBytesPerSec = HUFF_APP_ResultKiloBytesPerSec(Result);
+    if (BaseKiloBytesPerSec != 0)
+    {
+        SpeedupPermille = (uint32)(((uint64)KiloBytesPerSec * 1000) / BaseKiloBytesPerSec);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HUPD");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.InputMode);
+    HUFF_APP_ReportAddU32(&Report, Sched);
+    HUFF_APP_ReportAddU32(&Report, Workload->Length);
+    HUFF_APP_ReportAddU32(&Report, Workload->IndexEntries);
+    HUFF_APP_ReportAddU32(&Report, NumWorkers);
+    HUFF_APP_ReportAddU32(&Report, Result->Iterations);
+    HUFF_APP_ReportAddU32(&Report, Result->DurationMicros);
+    HUFF_APP_ReportAddHexU32(&Report, Result->Status);
+    HUFF_APP_ReportAddU32(&Report, KiloBytesPerSec);
+    HUFF_APP_ReportAddU32(&Report, SpeedupPermille);
+    HUFF_APP_ReportAddU32(&Report, Steals);
+    HUFF_APP_ReportSend(&Report);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode the current input with 1, 2, ... MaxWorkers decoders, emitting one  */
+/* record per worker count with the speedup over a single decoder             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ParDecRun(uint8 MaxWorkers, HUFF_APP_ParDecSched_Enum_t Sched)
+{
+    const HUFF_APP_Workload_t *Workload;
+    HUFF_APP_DecodeResult_t    Result;
+    CFE_Status_t               status;
+    int64                      StartMicros;
+    uint32                     BaseKiloBytesPerSec = 0;
+    uint32                     Steals;
+    uint8                      NumWorkers;
+
+    Workload = HUFF_APP_WorkloadCurrent();
+    if (Workload == NULL || Workload->IndexEntries == 0)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PARDEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Parallel decode needs a corpus or generated input");
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    if (MaxWorkers > HUFF_APP_PARDEC_MAX_WORKERS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PARDEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid parallel decode: %u workers, max %u", (unsigned int)MaxWorkers,
+                          (unsigned int)HUFF_APP_PARDEC_MAX_WORKERS);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+    if (Sched != HUFF_APP_ParDecSched_STATIC && Sched != HUFF_APP_ParDecSched_STEAL)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PARDEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid parallel decode schedule %u", (unsigned int)Sched);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+#ifndef HUFF_APP_PARDEC_STEAL_SUPPORTED
+    if (Sched == HUFF_APP_ParDecSched_STEAL)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PARDEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Work stealing needs C11 atomics, not available in this build");
+        return CFE_STATUS_RANGE_ERROR;
+    }
+#endif
+    if (MaxWorkers == 0)
+    {
+        MaxWorkers = HUFF_APP_PARDEC_MAX_WORKERS;
+    }
+
+    status = HUFF_APP_ParDecStart(MaxWorkers);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_PARDEC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Only %u parallel decode workers started, RC = 0x%08lX",
+                          (unsigned int)(1 + HUFF_APP_ParDecData.NumTasks), (unsigned long)status);
+        MaxWorkers = 1 + HUFF_APP_ParDecData.NumTasks;
+    }
+
+    for (NumWorkers = 1; NumWorkers <= MaxWorkers && !HUFF_APP_ExecCancelled(); NumWorkers++)
+    {
+        StartMicros = HUFF_APP_GetTimeMicros();
+        Steals      = HUFF_APP_ParDecSteals();
+        HUFF_APP_ParDecMeasure(Workload, NumWorkers, Sched, &Result);
+        if (NumWorkers == 1)
+        {
+            BaseKiloBytesPerSec = HUFF_APP_ResultKiloBytesPerSec(&Result);
+        }
+        HUFF_APP_ParDecReport(Workload, NumWorkers, Sched, &Result, BaseKiloBytesPerSec,
+                              HUFF_APP_ParDecSteals() - Steals, StartMicros);
+
+        if (Result.Status != CFE_SUCCESS && status == CFE_SUCCESS)
+        {
+            status = Result.Status;
+        }
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_PARDEC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Parallel decode of %lu blocks with 1 to %u workers (schedule %u) done, RC = 0x%08lX",
+                      (unsigned long)Workload->IndexEntries, (unsigned int)MaxWorkers, (unsigned int)Sched,
+                      (unsigned long)status);
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Housekeeping counters. A job may be running: the counters are only read.   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ParDecGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    const HUFF_APP_ParDecWorker_t *Worker;
+    HUFF_APP_ParDecWorkerTlm_t *   Tlm;
+    uint8                          i;
+
+    Hk->ParDecJobs   = HUFF_APP_ParDecData.Jobs;
+    Hk->ParDecSteals = HUFF_APP_ParDecSteals();
+
+    for (i = 0; i < HUFF_APP_PARDEC_MAX_WORKERS; i++)
+    {
+        Worker = &HUFF_APP_ParDecData.Worker[i];
+        Tlm    = &Hk->ParDecWorker[i];
+
+        Tlm->Chunks       = Worker->Chunks;
+        Tlm->Steals       = Worker->Steals;
+        Tlm->BusyMicros   = (uint32)Worker->BusyMicros;
+        Tlm->UtilPermille = 0;
+        if (Worker->JobMicros != 0)
+        {
+            Tlm->UtilPermille = (uint16)((Worker->BusyMicros * 1000) / Worker->JobMicros);
+        }
+    }
+}
+
+void HUFF_APP_ParDecResetStats(void)
+{
+    uint8 i;
+
+    HUFF_APP_ParDecData.Jobs = 0;
+
+    for (i = 0; i < HUFF_APP_PARDEC_MAX_WORKERS; i++)
+    {
+        HUFF_APP_ParDecData.Worker[i].Chunks     = 0;
+        HUFF_APP_ParDecData.Worker[i].Steals     = 0;
+        HUFF_APP_ParDecData.Worker[i].BusyMicros = 0;
+        HUFF_APP_ParDecData.Worker[i].JobMicros  = 0;
+    }
+}
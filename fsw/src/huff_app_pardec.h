@@ -0,0 +1,40 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App parallel block decode
+ */
+
+#ifndef HUFF_APP_PARDEC_H
+#define HUFF_APP_PARDEC_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_workload.h"
+
+CFE_Status_t HUFF_APP_ParDecStart(uint8 NumWorkers);
+int32        HUFF_APP_ParDecDecode(const HUFF_APP_Workload_t *Workload, uint8 NumWorkers,
+                                   HUFF_APP_ParDecSched_Enum_t Sched, uint8 *Out, HUFF_APP_DecodeResult_t *Result);
+CFE_Status_t HUFF_APP_ParDecRun(uint8 MaxWorkers, HUFF_APP_ParDecSched_Enum_t Sched);
+void         HUFF_APP_ParDecGetStats(HUFF_APP_HkTlm_Payload_t *Hk);
+void         HUFF_APP_ParDecResetStats(void);
+
+#endif /* HUFF_APP_PARDEC_H */
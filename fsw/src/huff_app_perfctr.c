@@ -0,0 +1,185 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App hardware performance counters.
+ *
+ *   On Linux the counters are opened with perf_event_open() for the calling
+ *   task. On other OSAL targets every function is a no-op and no counter is
+ *   reported as available.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_perfctr.h"
+
+#ifdef __linux__
+
+typedef struct
+{
+    uint32 HwType;
+    uint64 HwConfig;
+    uint64 SwConfig;
+} HUFF_APP_PerfCtrEvent_t;
+
+static const HUFF_APP_PerfCtrEvent_t HUFF_APP_PerfCtrEvents[HUFF_APP_PERFCTR_COUNT] = {
+    [HUFF_APP_PERFCTR_CYCLES]        = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_SW_TASK_CLOCK},
+    [HUFF_APP_PERFCTR_INSTRUCTIONS]  = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    [HUFF_APP_PERFCTR_CACHE_REFS]    = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_SW_PAGE_FAULTS},
+    [HUFF_APP_PERFCTR_CACHE_MISSES]  = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_SW_CPU_MIGRATIONS},
+    [HUFF_APP_PERFCTR_BRANCH_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_PAGE_FAULTS_MIN},
+};
+
+static int   HUFF_APP_PerfCtrFd[HUFF_APP_PERFCTR_COUNT] = {-1, -1, -1, -1, -1};
+static uint8 HUFF_APP_PerfCtrOpenMask;
+static uint8 HUFF_APP_PerfCtrSoftwareMask;
+
+static int HUFF_APP_PerfCtrOpen(uint32 Type, uint64 Config)
+{
+    struct perf_event_attr Attr;
+
+    memset(&Attr, 0, sizeof(Attr));
+    Attr.size           = sizeof(Attr);
+    Attr.type           = Type;
+    Attr.config         = Config;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv     = 1;
+
+    /* Count the calling task on any CPU */
+    return (int)syscall(__NR_perf_event_open, &Attr, 0, -1, -1, 0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Open the counters for the calling task                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_PerfCtrInit(void)
+{
+    int i;
+
+    HUFF_APP_PerfCtrOpenMask     = 0;
+    HUFF_APP_PerfCtrSoftwareMask = 0;
+
+    for (i = 0; i < HUFF_APP_PERFCTR_COUNT; i++)
+    {
+        if (HUFF_APP_PerfCtrFd[i] >= 0)
+        {
+            close(HUFF_APP_PerfCtrFd[i]);
+        }
+
+        HUFF_APP_PerfCtrFd[i] = HUFF_APP_PerfCtrOpen(HUFF_APP_PerfCtrEvents[i].HwType, HUFF_APP_PerfCtrEvents[i].HwConfig);
+        if (HUFF_APP_PerfCtrFd[i] < 0)
+        {
+            HUFF_APP_PerfCtrFd[i] = HUFF_APP_PerfCtrOpen(PERF_TYPE_SOFTWARE, HUFF_APP_PerfCtrEvents[i].SwConfig);
+            if (HUFF_APP_PerfCtrFd[i] >= 0)
+            {
+                HUFF_APP_PerfCtrSoftwareMask |= (1 << i);
+            }
+        }
+
+        if (HUFF_APP_PerfCtrFd[i] >= 0)
+        {
+            HUFF_APP_PerfCtrOpenMask |= (1 << i);
+        }
+    }
+
+    if (HUFF_APP_PerfCtrOpenMask == 0)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: No performance counter available\n");
+    }
+    else if (HUFF_APP_PerfCtrSoftwareMask != 0)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: Performance counters 0x%02X use software events\n",
+                             (unsigned int)HUFF_APP_PerfCtrSoftwareMask);
+    }
+}
+
+bool HUFF_APP_PerfCtrAvailable(void)
+{
+    return HUFF_APP_PerfCtrOpenMask != 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Read the current counter values                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_PerfCtrRead(HUFF_APP_PerfCtrValues_t *Values)
+{
+    int i;
+
+    Values->OpenMask     = HUFF_APP_PerfCtrOpenMask;
+    Values->SoftwareMask = HUFF_APP_PerfCtrSoftwareMask;
+
+    for (i = 0; i < HUFF_APP_PERFCTR_COUNT; i++)
+    {
+        Values->Value[i] = 0;
+        if (HUFF_APP_PerfCtrFd[i] >= 0 &&
+            read(HUFF_APP_PerfCtrFd[i], &Values->Value[i], sizeof(Values->Value[i])) != sizeof(Values->Value[i]))
+        {
+            Values->Value[i] = 0;
+        }
+    }
+}
+
+#else /* !__linux__ */
+
+void HUFF_APP_PerfCtrInit(void) {}
+
+bool HUFF_APP_PerfCtrAvailable(void)
+{
+    return false;
+}
+
+void HUFF_APP_PerfCtrRead(HUFF_APP_PerfCtrValues_t *Values)
+{
+    memset(Values, 0, sizeof(*Values));
+}
+
+#endif /* __linux__ */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Counter increments between two reads                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_PerfCtrDelta(const HUFF_APP_PerfCtrValues_t *Before, const HUFF_APP_PerfCtrValues_t *After,
+                           HUFF_APP_PerfCtrValues_t *Delta)
+{
+    int i;
+
+    Delta->OpenMask     = After->OpenMask;
+    Delta->SoftwareMask = After->SoftwareMask;
+
+    for (i = 0; i < HUFF_APP_PERFCTR_COUNT; i++)
+    {
+        Delta->Value[i] = After->Value[i] - Before->Value[i];
+    }
+}
@@ -0,0 +1,60 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App hardware performance counters
+ */
+
+#ifndef HUFF_APP_PERFCTR_H
+#define HUFF_APP_PERFCTR_H
+
+/*
+** Required header files.
+*/
+#include "common_types.h"
+
+/*
+** Counter slots. When the hardware event of a slot cannot be opened, the
+** software event listed next to it is counted instead and the slot bit is
+** set in HUFF_APP_PerfCtrValues_t::SoftwareMask.
+*/
+enum
+{
+    HUFF_APP_PERFCTR_CYCLES        = 0, /* CPU cycles, or task clock (ns) */
+    HUFF_APP_PERFCTR_INSTRUCTIONS  = 1, /* Retired instructions, or context switches */
+    HUFF_APP_PERFCTR_CACHE_REFS    = 2, /* Cache references, or page faults */
+    HUFF_APP_PERFCTR_CACHE_MISSES  = 3, /* Cache misses, or CPU migrations */
+    HUFF_APP_PERFCTR_BRANCH_MISSES = 4, /* Branch mispredictions, or minor page faults */
+    HUFF_APP_PERFCTR_COUNT         = 5
+};
+
+typedef struct
+{
+    uint64 Value[HUFF_APP_PERFCTR_COUNT];
+    uint8  OpenMask;     /* Slots with an open counter */
+    uint8  SoftwareMask; /* Slots counting the software fallback event */
+} HUFF_APP_PerfCtrValues_t;
+
+void HUFF_APP_PerfCtrInit(void);
+bool HUFF_APP_PerfCtrAvailable(void);
+void HUFF_APP_PerfCtrRead(HUFF_APP_PerfCtrValues_t *Values);
+void HUFF_APP_PerfCtrDelta(const HUFF_APP_PerfCtrValues_t *Before, const HUFF_APP_PerfCtrValues_t *After,
+                           HUFF_APP_PerfCtrValues_t *Delta);
+
+#endif /* HUFF_APP_PERFCTR_H */
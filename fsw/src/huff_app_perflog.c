@@ -0,0 +1,169 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App CFE_ES performance
+ *   log captures.
+ *
+ *   Apps cannot drive the ES performance log through the ES API, so the
+ *   capture is set up with the same commands a ground operator would send:
+ *   filter and trigger masks, start, then stop with the file name. The
+ *   filter keeps only this app's performance IDs and the trigger is the
+ *   first capture run. After the capture the filter passes every ID again
+ *   and the trigger mask is cleared, the ES defaults.
+ *
+ *   ES handles its command pipe asynchronously, so each step leaves it
+ *   HUFF_APP_PERFCAP_SETTLE_MS to take effect.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_perflog.h"
+
+#include "cfe_es_msg.h"
+#include "cfe_es_msgids.h"
+
+#define HUFF_APP_PERFLOG_MASK_WORDS (CFE_MISSION_ES_PERF_MAX_IDS / 32)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Mask word Word with the bits of the given performance IDs                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_PerfLogMask(uint32 Word, const uint32 *Ids, uint32 NumIds)
+{
+    uint32 Mask = 0;
+    uint32 i;
+
+    for (i = 0; i < NumIds; i++)
+    {
+        if (Ids[i] / 32 == Word)
+        {
+            Mask |= 1u << (Ids[i] % 32);
+        }
+    }
+
+    return Mask;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Send one command to ES                                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t HUFF_APP_PerfLogSend(CFE_MSG_Message_t *MsgPtr, size_t Size, CFE_MSG_FcnCode_t CommandCode)
+{
+    CFE_MSG_Init(MsgPtr, CFE_SB_ValueToMsgId(CFE_ES_CMD_MID), Size);
+    CFE_MSG_SetFcnCode(MsgPtr, CommandCode);
+    CFE_MSG_GenerateChecksum(MsgPtr);
+
+    return CFE_SB_TransmitMsg(MsgPtr, true);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Set every filter and trigger mask word, a NULL filter passing every ID     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t HUFF_APP_PerfLogSetMasks(const uint32 *FilterIds, uint32 NumFilterIds, const uint32 *TriggerIds,
+                                             uint32 NumTriggerIds)
+{
+    CFE_ES_SetPerfFilterMaskCmd_t  FilterCmd;
+    CFE_ES_SetPerfTriggerMaskCmd_t TriggerCmd;
+    CFE_Status_t                   status = CFE_SUCCESS;
+    uint32                         Word;
+
+    for (Word = 0; Word < HUFF_APP_PERFLOG_MASK_WORDS && status == CFE_SUCCESS; Word++)
+    {
+        memset(&FilterCmd, 0, sizeof(FilterCmd));
+        FilterCmd.Payload.FilterMaskNum = Word;
+        FilterCmd.Payload.FilterMask =
+            (FilterIds == NULL) ? 0xFFFFFFFF : HUFF_APP_PerfLogMask(Word, FilterIds, NumFilterIds);
+        status = HUFF_APP_PerfLogSend(CFE_MSG_PTR(FilterCmd.CommandHeader), sizeof(FilterCmd),
+                                      CFE_ES_SET_PERF_FILTER_MASK_CC);
+
+        if (status == CFE_SUCCESS)
+        {
+            memset(&TriggerCmd, 0, sizeof(TriggerCmd));
+            TriggerCmd.Payload.TriggerMaskNum = Word;
+            TriggerCmd.Payload.TriggerMask    = HUFF_APP_PerfLogMask(Word, TriggerIds, NumTriggerIds);
+            status = HUFF_APP_PerfLogSend(CFE_MSG_PTR(TriggerCmd.CommandHeader), sizeof(TriggerCmd),
+                                          CFE_ES_SET_PERF_TRIGGER_MASK_CC);
+        }
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Filter the log to this app, trigger on the first capture run and start    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_PerfLogStart(void)
+{
+    static const uint32 FilterIds[]  = {HUFF_APP_PERF_ID, HUFF_APP_SERVICE_PERF_ID, HUFF_APP_EXEC_PERF_ID,
+                                       HUFF_APP_RUN_PERF_ID};
+    static const uint32 TriggerIds[] = {HUFF_APP_RUN_PERF_ID};
+
+    CFE_ES_StartPerfDataCmd_t StartCmd;
+    CFE_Status_t              status;
+
+    status = HUFF_APP_PerfLogSetMasks(FilterIds, sizeof(FilterIds) / sizeof(FilterIds[0]), TriggerIds,
+                                      sizeof(TriggerIds) / sizeof(TriggerIds[0]));
+
+    if (status == CFE_SUCCESS)
+    {
+        memset(&StartCmd, 0, sizeof(StartCmd));
+        StartCmd.Payload.TriggerMode = CFE_ES_PERF_TRIGGER_START;
+        status = HUFF_APP_PerfLogSend(CFE_MSG_PTR(StartCmd.CommandHeader), sizeof(StartCmd),
+                                      CFE_ES_START_PERF_DATA_CC);
+    }
+
+    OS_TaskDelay(HUFF_APP_PERFCAP_SETTLE_MS);
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Stop the capture, have ES write the log and restore the default masks     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_PerfLogStop(const char *FileName)
+{
+    CFE_ES_StopPerfDataCmd_t StopCmd;
+    CFE_Status_t             status;
+    CFE_Status_t             MaskStatus;
+
+    /* Let the exit stamps of the last run reach the log */
+    OS_TaskDelay(HUFF_APP_PERFCAP_SETTLE_MS);
+
+    memset(&StopCmd, 0, sizeof(StopCmd));
+    strncpy(StopCmd.Payload.DataFileName, FileName, sizeof(StopCmd.Payload.DataFileName) - 1);
+
+    status = HUFF_APP_PerfLogSend(CFE_MSG_PTR(StopCmd.CommandHeader), sizeof(StopCmd), CFE_ES_STOP_PERF_DATA_CC);
+
+    /* ES takes its commands in order, so the restored filter only applies after the stop */
+    MaskStatus = HUFF_APP_PerfLogSetMasks(NULL, 0, NULL, 0);
+
+    return (status != CFE_SUCCESS) ? status : MaskStatus;
+}
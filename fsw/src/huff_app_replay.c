@@ -0,0 +1,302 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App seed replay log.
+ *
+ *   Every run on the bench_lib seed chain is remembered in a small ring:
+ *   the seed it started from, its iteration count, duration and status.
+ *   As the chain only depends on the starting seed, a logged run can be
+ *   decoded again, bit for bit, long after the chain has moved on. Replaying
+ *   a slow run many times in a row tells an input that is slow to decode
+ *   (the replays are slow too) from a run that was disturbed (they are not).
+ *
+ *   Logging and replays both run on the executor task, so the ring needs no
+ *   locking.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_replay.h"
+#include "huff_app_utils.h"
+
+/*
+** One logged run
+*/
+typedef struct
+{
+    uint32 Seq;            /* Number of the run since the app started, from 1 */
+    uint16 Seed;           /* First seed of the chain */
+    uint8  Table;          /* Code table of the last invocation */
+    uint8  Unstable;       /* Flagged by the stability guard */
+    uint32 Iterations;     /* Invocations in the run */
+    uint32 DurationMicros; /* Elapsed time of the run */
+    int32  Status;         /* First failing bench_lib return code */
+} HUFF_APP_ReplayEntry_t;
+
+typedef struct
+{
+    HUFF_APP_ReplayEntry_t Entry[HUFF_APP_REPLAY_LOG_ENTRIES];
+    uint32                 NextSeq; /* Runs logged so far */
+
+    /* Times per invocation of the replays of one seed, too large for the executor stack */
+    uint32 Nanos[HUFF_APP_REPLAY_MAX_REPEATS];
+} HUFF_APP_ReplayData_t;
+
+static HUFF_APP_ReplayData_t HUFF_APP_ReplayData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Time per invocation of a logged run                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 HUFF_APP_ReplayEntryNanos(const HUFF_APP_ReplayEntry_t *Entry)
+{
+    return (uint32)(((uint64)Entry->DurationMicros * 1000) / Entry->Iterations);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Remember a run of the seed chain                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_ReplayLog(const HUFF_APP_Sample_t *Sample)
+{
+    HUFF_APP_ReplayEntry_t *Entry;
+
+    Entry = &HUFF_APP_ReplayData.Entry[HUFF_APP_ReplayData.NextSeq & (HUFF_APP_REPLAY_LOG_ENTRIES - 1)];
+
+    Entry->Seq            = HUFF_APP_ReplayData.NextSeq + 1;
+    Entry->Seed           = Sample->Seed;
+    Entry->Table          = Sample->Table;
+    Entry->Unstable       = Sample->Unstable;
+    Entry->Iterations     = Sample->Iterations;
+    Entry->DurationMicros = (uint32)Sample->DurationMicros;
+    Entry->Status         = Sample->Status;
+
+    HUFF_APP_ReplayData.NextSeq++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Logged run Back runs before the most recent one, NULL when it   */
+/* has been overwritten or never happened                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static const HUFF_APP_ReplayEntry_t *HUFF_APP_ReplayEntry(uint32 Back)
+{
+    uint32 Logged = HUFF_APP_ReplayData.NextSeq;
+
+    if (Logged > HUFF_APP_REPLAY_LOG_ENTRIES)
+    {
+        Logged = HUFF_APP_REPLAY_LOG_ENTRIES;
+    }
+    if (Back >= Logged)
+    {
+        return NULL;
+    }
+
+    return &HUFF_APP_ReplayData.Entry[(HUFF_APP_ReplayData.NextSeq - 1 - Back) & (HUFF_APP_REPLAY_LOG_ENTRIES - 1)];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Send the Count most recent log entries, oldest first            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 HUFF_APP_ReplayDump(uint32 Count)
+{
+    const HUFF_APP_ReplayEntry_t *Entry;
+    HUFF_APP_Report_t             Report;
+    uint32                        Back;
+    uint32                        Sent = 0;
+
+    /* Paced, and left early on cancel, so the whole log does not flood the telemetry pipes */
+    for (Back = Count; Back-- > 0 && !HUFF_APP_ExecCancelled();)
+    {
+        Entry = HUFF_APP_ReplayEntry(Back);
+        if (Entry == NULL)
+        {
+            continue;
+        }
+
+        HUFF_APP_ReportInit(&Report, "$HURL");
+        HUFF_APP_ReportAddU32(&Report, Entry->Seq);
+        HUFF_APP_ReportAddHexU16(&Report, Entry->Seed);
+        HUFF_APP_ReportAddHexU8(&Report, Entry->Table);
+        HUFF_APP_ReportAddU32(&Report, Entry->Iterations);
+        HUFF_APP_ReportAddU32(&Report, Entry->DurationMicros);
+        HUFF_APP_ReportAddU32(&Report, HUFF_APP_ReplayEntryNanos(Entry));
+        HUFF_APP_ReportAddHexU32(&Report, Entry->Status);
+        HUFF_APP_ReportAddU32(&Report, Entry->Unstable);
+        HUFF_APP_ReportSend(&Report);
+        HUFF_APP_ReportPace(++Sent);
+    }
+
+    return Sent;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Run one seed Repeats times and report the spread of its times,  */
+/* next to the logged time of the original run when there is one   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 HUFF_APP_ReplaySeed(uint16 Seed, uint32 Iterations, const HUFF_APP_ReplayEntry_t *Logged,
+                                  uint16 Repeats)
+{
+    HUFF_APP_ReplayData_t *Data = &HUFF_APP_ReplayData;
+    HUFF_APP_Sample_t      Sample;
+    HUFF_APP_Report_t      Report;
+    int64                  StartMicros;
+    uint32                 Count    = 0;
+    uint32                 Failures = 0;
+    uint32                 MinNanos = 0;
+    uint32                 MaxNanos = 0;
+    uint32                 MedianNanos;
+    uint32                 MadNanos;
+    uint32                 LoggedNanos = 0;
+    uint32                 i;
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    for (i = 0; i < Repeats && !HUFF_APP_ExecCancelled(); i++)
+    {
+        HUFF_APP_BenchGuardedSample(Seed, Iterations, &Sample);
+        if (Sample.Status != CFE_SUCCESS)
+        {
+            Failures++;
+            continue;
+        }
+
+        Data->Nanos[Count++] = HUFF_APP_SampleNanosPerIteration(&Sample);
+    }
+
+    if (Count == 0)
+    {
+        return Failures;
+    }
+
+    /* Sorting for the median also gives the extremes */
+    MedianNanos = HUFF_APP_MedianU32(Data->Nanos, Count);
+    MinNanos    = Data->Nanos[0];
+    MaxNanos    = Data->Nanos[Count - 1];
+    for (i = 0; i < Count; i++)
+    {
+        Data->Nanos[i] =
+            (Data->Nanos[i] > MedianNanos) ? (Data->Nanos[i] - MedianNanos) : (MedianNanos - Data->Nanos[i]);
+    }
+    MadNanos = HUFF_APP_MedianU32(Data->Nanos, Count);
+
+    if (Logged != NULL)
+    {
+        LoggedNanos = HUFF_APP_ReplayEntryNanos(Logged);
+    }
+
+    HUFF_APP_ReportInit(&Report, "$HURP");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddHexU16(&Report, Seed);
+    HUFF_APP_ReportAddU32(&Report, (Logged != NULL) ? Logged->Seq : 0);
+    HUFF_APP_ReportAddU32(&Report, Iterations);
+    HUFF_APP_ReportAddU32(&Report, Count);
+    HUFF_APP_ReportAddU32(&Report, LoggedNanos);
+    HUFF_APP_ReportAddU32(&Report, MinNanos);
+    HUFF_APP_ReportAddU32(&Report, MedianNanos);
+    HUFF_APP_ReportAddU32(&Report, MaxNanos);
+    HUFF_APP_ReportAddU32(&Report, MadNanos);
+    HUFF_APP_ReportAddU32(&Report, (LoggedNanos != 0) ? (uint32)(((uint64)LoggedNanos * 1000) / MedianNanos) : 0);
+    HUFF_APP_ReportAddU32(&Report, Failures);
+    HUFF_APP_ReportSend(&Report);
+
+    return Failures;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Replay Seed, or the Count most recently logged runs, Repeats times each.   */
+/* With Repeats at zero, send the log itself.                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ReplayRun(uint16 Seed, uint16 Count, uint16 Repeats)
+{
+    const HUFF_APP_ReplayEntry_t *Logged;
+    uint32                        Seeds    = 0;
+    uint32                        Failures = 0;
+    uint32                        Back;
+
+    if (Repeats > HUFF_APP_REPLAY_MAX_REPEATS || Count > HUFF_APP_REPLAY_LOG_ENTRIES)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_REPLAY_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid replay: Count = %u, Repeats = %u", (unsigned int)Count,
+                          (unsigned int)Repeats);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    if (Repeats == 0)
+    {
+        Seeds = HUFF_APP_ReplayDump((Count != 0) ? Count : HUFF_APP_REPLAY_LOG_ENTRIES);
+
+        CFE_EVS_SendEvent(HUFF_APP_REPLAY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "HUFF: Replay log: %lu runs sent, %lu logged since start", (unsigned long)Seeds,
+                          (unsigned long)HUFF_APP_ReplayData.NextSeq);
+        return CFE_SUCCESS;
+    }
+
+    if (Count == 0)
+    {
+        /* Same iteration count as the latest logged run of the seed, so the same invocations are timed */
+        for (Back = 0; (Logged = HUFF_APP_ReplayEntry(Back)) != NULL; Back++)
+        {
+            if (Logged->Seed == Seed)
+            {
+                break;
+            }
+        }
+
+        Failures = HUFF_APP_ReplaySeed(Seed, (Logged != NULL) ? Logged->Iterations : HUFF_APP_Data.IterationCount,
+                                       Logged, Repeats);
+        Seeds    = 1;
+    }
+    else
+    {
+        /* Replays are not logged, so the ring holds still while it is walked */
+        for (Back = Count; Back-- > 0 && !HUFF_APP_ExecCancelled();)
+        {
+            Logged = HUFF_APP_ReplayEntry(Back);
+            if (Logged == NULL)
+            {
+                continue;
+            }
+
+            Failures += HUFF_APP_ReplaySeed(Logged->Seed, Logged->Iterations, Logged, Repeats);
+            Seeds++;
+        }
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_REPLAY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Replayed %lu seeds x%u, %lu samples failed", (unsigned long)Seeds,
+                      (unsigned int)Repeats, (unsigned long)Failures);
+
+    return CFE_SUCCESS;
+}
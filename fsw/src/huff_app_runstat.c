@@ -0,0 +1,101 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App run counters.
+ *
+ *   Runs are counted by outcome. Every timed decode, bench_lib samples and
+ *   in-app codec decodes alike, adds the output bytes and symbols it
+ *   decoded, so HK shows the same kB/s as the result sentences. The counts
+ *   are only written by the executor task; the decoded totals are 64-bit
+ *   and read by the main task for HK, so they are kept atomic.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdatomic.h>
+
+#include "huff_app.h"
+#include "huff_app_runstat.h"
+
+typedef struct
+{
+    uint32 Runs;
+    uint32 Successes;
+    uint32 Failures;
+
+    atomic_ullong DecodedBytes;
+    atomic_ullong DecodedSymbols;
+} HUFF_APP_RunStatData_t;
+
+static HUFF_APP_RunStatData_t HUFF_APP_RunStatData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Count a completed run                                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_RunStatDone(int32 Status)
+{
+    HUFF_APP_RunStatData.Runs++;
+
+    if (Status == CFE_SUCCESS)
+    {
+        HUFF_APP_RunStatData.Successes++;
+    }
+    else
+    {
+        HUFF_APP_RunStatData.Failures++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Add the output volume of a timed decode                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_RunStatDecoded(uint64 Bytes, uint64 Symbols)
+{
+    atomic_fetch_add(&HUFF_APP_RunStatData.DecodedBytes, Bytes);
+    atomic_fetch_add(&HUFF_APP_RunStatData.DecodedSymbols, Symbols);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Housekeeping counters                                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_RunStatGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    Hk->RunCount        = HUFF_APP_RunStatData.Runs;
+    Hk->RunSuccessCount = HUFF_APP_RunStatData.Successes;
+    Hk->RunFailureCount = HUFF_APP_RunStatData.Failures;
+    Hk->DecodedBytes    = atomic_load(&HUFF_APP_RunStatData.DecodedBytes);
+    Hk->DecodedSymbols  = atomic_load(&HUFF_APP_RunStatData.DecodedSymbols);
+}
+
+void HUFF_APP_RunStatResetStats(void)
+{
+    HUFF_APP_RunStatData.Runs      = 0;
+    HUFF_APP_RunStatData.Successes = 0;
+    HUFF_APP_RunStatData.Failures  = 0;
+    atomic_store(&HUFF_APP_RunStatData.DecodedBytes, 0);
+    atomic_store(&HUFF_APP_RunStatData.DecodedSymbols, 0);
+}
@@ -0,0 +1,408 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App decode service.
+ *
+ *   Other apps send Huffman-encoded blocks on HUFF_APP_DECODE_REQ_MID. A
+ *   child task with its own pipe drains the requests in batches, decodes
+ *   each block directly into a software bus buffer and publishes it on
+ *   HUFF_APP_DECODE_RSP_MID with the requester's correlation ID.
+ *
+ *   Code book IDs index a small registry of decode tables. ID 0 follows the
+ *   book of the current corpus or generated input, the next IDs the books
+ *   of the code book table.
+ *
+ *   Each book has two cache line aligned decode table banks. Decodes take a
+ *   reference on the active bank and run without holding the lock. The one
+ *   task changing a book builds the new table in the other bank once its
+ *   last decode has finished, then makes it active, so in-flight decodes
+ *   finish on the table they started with.
+ */
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+
+#include "huff_app.h"
+#include "huff_app_eventids.h"
+#include "huff_app_service.h"
+#include "huff_app_trace.h"
+#include "huff_app_utils.h"
+
+/* Cache line size the decode tables are aligned on */
+#define HUFF_APP_SERVICE_LINE_SIZE 64
+
+typedef struct
+{
+    HUFF_APP_DecodeTable_t Bank[2] __attribute__((aligned(HUFF_APP_SERVICE_LINE_SIZE)));
+    bool                   Valid[2];
+    uint8                  Active;      /* Bank new decodes start on */
+    uint32                 RefCount[2]; /* Decodes in flight on each bank */
+} HUFF_APP_ServiceBook_t;
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    CFE_SB_PipeId_t Pipe;
+    osal_id_t       Mutex; /* Protects the bank selection, reference counts and counters */
+
+    HUFF_APP_ServiceBook_t     Book[HUFF_APP_SERVICE_MAX_BOOKS];
+    HUFF_APP_DecodeClientTlm_t Client[HUFF_APP_DECODE_MAX_CLIENTS];
+    uint32                     UntrackedRequests;
+} HUFF_APP_ServiceData_t;
+
+static HUFF_APP_ServiceData_t HUFF_APP_ServiceData;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Counters of a client, taking a free slot on its first request              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static HUFF_APP_DecodeClientTlm_t *HUFF_APP_ServiceClient(uint16 ClientId)
+{
+    HUFF_APP_DecodeClientTlm_t *Client;
+    uint32                      i;
+
+    for (i = 0; i < HUFF_APP_DECODE_MAX_CLIENTS; i++)
+    {
+        Client = &HUFF_APP_ServiceData.Client[i];
+        if (Client->Requests == 0)
+        {
+            Client->ClientId = ClientId;
+            return Client;
+        }
+        if (Client->ClientId == ClientId)
+        {
+            return Client;
+        }
+    }
+
+    return NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Take a reference on the active decode table of a book                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static const HUFF_APP_DecodeTable_t *HUFF_APP_ServiceAcquire(uint16 BookId, uint8 *Bank)
+{
+    HUFF_APP_ServiceBook_t *Book  = &HUFF_APP_ServiceData.Book[BookId];
+    HUFF_APP_DecodeTable_t *Table = NULL;
+
+    OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+    *Bank = Book->Active;
+    if (Book->Valid[*Bank])
+    {
+        Book->RefCount[*Bank]++;
+        Table = &Book->Bank[*Bank];
+    }
+    OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+
+    return Table;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode one request into a response buffer and publish it                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ServiceRequest(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    const HUFF_APP_DecodeReq_Payload_t *Req = &((const HUFF_APP_DecodeReqCmd_t *)SBBufPtr)->Payload;
+    HUFF_APP_DecodeRspTlm_t *           Rsp;
+    HUFF_APP_DecodeClientTlm_t *        Client;
+    const HUFF_APP_DecodeTable_t *      Table = NULL;
+    uint8                               Bank  = 0;
+    CFE_Status_t                        status;
+    size_t                              MsgSize = 0;
+    size_t                              NumSymbols;
+    int64                               StartMicros;
+    int64                               DecodeMicros = 0;
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &MsgSize);
+    if (MsgSize < offsetof(HUFF_APP_DecodeReqCmd_t, Payload.Data))
+    {
+        /* Without a correlation ID there is nobody to answer */
+        CFE_EVS_SendEvent(HUFF_APP_SERVICE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Dropped short decode request, Len = %lu", (unsigned long)MsgSize);
+        return;
+    }
+
+    status     = CFE_SUCCESS;
+    NumSymbols = Req->NumSymbols;
+
+    if (Req->EncodedBytes > HUFF_APP_DECODE_MAX_ENC_BYTES ||
+        MsgSize < offsetof(HUFF_APP_DecodeReqCmd_t, Payload.Data) + Req->EncodedBytes)
+    {
+        status = CFE_STATUS_WRONG_MSG_LENGTH;
+    }
+    else if (NumSymbols > HUFF_APP_DECODE_MAX_SYMBOLS)
+    {
+        status = CFE_STATUS_RANGE_ERROR;
+    }
+    else if (Req->BookId >= HUFF_APP_SERVICE_MAX_BOOKS)
+    {
+        status = CFE_STATUS_INCORRECT_STATE;
+    }
+    else
+    {
+        Table = HUFF_APP_ServiceAcquire(Req->BookId, &Bank);
+        if (Table == NULL)
+        {
+            status = CFE_STATUS_INCORRECT_STATE;
+        }
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        NumSymbols = 0;
+    }
+
+    Rsp = (HUFF_APP_DecodeRspTlm_t *)CFE_SB_AllocateMessageBuffer(offsetof(HUFF_APP_DecodeRspTlm_t, Payload.Data) +
+                                                                    NumSymbols);
+    if (Rsp == NULL)
+    {
+        status     = CFE_SB_BUF_ALOC_ERR;
+        NumSymbols = 0;
+    }
+    else
+    {
+        CFE_MSG_Init(CFE_MSG_PTR(Rsp->TelemetryHeader), CFE_SB_ValueToMsgId(HUFF_APP_DECODE_RSP_MID),
+                     offsetof(HUFF_APP_DecodeRspTlm_t, Payload.Data) + NumSymbols);
+
+        if (NumSymbols != 0)
+        {
+            HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DECODE);
+            StartMicros = HUFF_APP_GetTimeMicros();
+            status = HUFF_APP_CodecDecode(Table, Req->Data, Req->EncodedBytes, Rsp->Payload.Data, NumSymbols);
+            DecodeMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+            HUFF_APP_TRACE_END(HUFF_APP_TRACE_DECODE);
+
+            if (status != CFE_SUCCESS)
+            {
+                NumSymbols = 0;
+                CFE_MSG_SetSize(CFE_MSG_PTR(Rsp->TelemetryHeader), offsetof(HUFF_APP_DecodeRspTlm_t, Payload.Data));
+            }
+        }
+
+        Rsp->Payload.CorrelationId = Req->CorrelationId;
+        Rsp->Payload.ClientId      = Req->ClientId;
+        Rsp->Payload.BookId        = Req->BookId;
+        Rsp->Payload.Status        = status;
+        Rsp->Payload.NumSymbols    = NumSymbols;
+
+        HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_TRANSMIT);
+        CFE_SB_TimeStampMsg(CFE_MSG_PTR(Rsp->TelemetryHeader));
+        if (CFE_SB_TransmitBuffer((CFE_SB_Buffer_t *)Rsp, true) != CFE_SUCCESS)
+        {
+            CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)Rsp);
+            status = CFE_SB_BUF_ALOC_ERR;
+        }
+        HUFF_APP_TRACE_END(HUFF_APP_TRACE_TRANSMIT);
+    }
+
+    OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+
+    if (Table != NULL)
+    {
+        HUFF_APP_ServiceData.Book[Req->BookId].RefCount[Bank]--;
+    }
+
+    Client = HUFF_APP_ServiceClient(Req->ClientId);
+    if (Client == NULL)
+    {
+        HUFF_APP_ServiceData.UntrackedRequests++;
+    }
+    else
+    {
+        Client->Requests++;
+        if (status != CFE_SUCCESS)
+        {
+            Client->Errors++;
+        }
+        else
+        {
+            Client->EncodedBytes += Req->EncodedBytes;
+            Client->Symbols += NumSymbols;
+            Client->DecodeMicros += DecodeMicros;
+        }
+    }
+
+    OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Service child task entry point                                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_ServiceTaskMain(void)
+{
+    CFE_SB_Buffer_t *SBBufPtr;
+    CFE_Status_t     status;
+    uint32           Handled;
+
+    HUFF_APP_TraceAttach("HUFF_SERVICE");
+
+    while (HUFF_APP_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+    {
+        HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_RECEIVE);
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, HUFF_APP_ServiceData.Pipe, CFE_SB_PEND_FOREVER);
+        HUFF_APP_TRACE_END(HUFF_APP_TRACE_RECEIVE);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_SERVICE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Decode service pipe read error, RC = 0x%08lX, service stopped",
+                              (unsigned long)status);
+            break;
+        }
+
+        CFE_ES_PerfLogEntry(HUFF_APP_SERVICE_PERF_ID);
+
+        /* Drain what is already queued, up to a batch */
+        Handled = 0;
+        do
+        {
+            HUFF_APP_ServiceRequest(SBBufPtr);
+            Handled++;
+        } while (Handled < HUFF_APP_SERVICE_BATCH_SIZE &&
+                 CFE_SB_ReceiveBuffer(&SBBufPtr, HUFF_APP_ServiceData.Pipe, CFE_SB_POLL) == CFE_SUCCESS);
+
+        CFE_ES_PerfLogExit(HUFF_APP_SERVICE_PERF_ID);
+    }
+
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Create the request pipe and start the service task                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ServiceInit(void)
+{
+    CFE_Status_t status;
+
+    memset(&HUFF_APP_ServiceData, 0, sizeof(HUFF_APP_ServiceData));
+
+    if (OS_MutSemCreate(&HUFF_APP_ServiceData.Mutex, "HUFF_SVC_MUT", 0) != OS_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    status = CFE_SB_CreatePipe(&HUFF_APP_ServiceData.Pipe, HUFF_APP_SERVICE_PIPE_DEPTH, "HUFF_APP_SVC_PIPE");
+    if (status == CFE_SUCCESS)
+    {
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(HUFF_APP_DECODE_REQ_MID), HUFF_APP_ServiceData.Pipe);
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        status = CFE_ES_CreateChildTask(&HUFF_APP_ServiceData.TaskId, "HUFF_SVC", HUFF_APP_ServiceTaskMain,
+                                        CFE_ES_TASK_STACK_ALLOCATE, HUFF_APP_SERVICE_STACK_SIZE,
+                                        HUFF_APP_SERVICE_PRIORITY, 0);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Install the decode table of a code book under an ID, or remove it. Each    */
+/* ID has a single writer: the benchmark executor for ID 0 (current input),   */
+/* the app main task for the table books.                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_ServiceSetBook(uint16 BookId, const HUFF_APP_CodeBook_t *Book)
+{
+    HUFF_APP_ServiceBook_t *Slot;
+    uint32                  Waited = 0;
+    uint8                   Spare;
+    bool                    Busy;
+
+    if (BookId >= HUFF_APP_SERVICE_MAX_BOOKS)
+    {
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    Slot = &HUFF_APP_ServiceData.Book[BookId];
+
+    /* Wait for the decodes still running on the spare bank, they are short */
+    while (true)
+    {
+        OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+        Spare = 1 - Slot->Active;
+        Busy  = (Slot->RefCount[Spare] != 0);
+        OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+
+        if (!Busy)
+        {
+            break;
+        }
+        if (Waited >= HUFF_APP_SERVICE_SWAP_TIMEOUT)
+        {
+            return CFE_STATUS_REQUEST_ALREADY_PENDING;
+        }
+
+        OS_TaskDelay(1);
+        Waited++;
+    }
+
+    /* Nothing can start on the spare bank, so it is built without the lock */
+    if (Book != NULL)
+    {
+        HUFF_APP_CodecBuildDecodeTable(Book, &Slot->Bank[Spare]);
+    }
+
+    OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+    Slot->Valid[Spare] = (Book != NULL);
+    Slot->Active       = Spare;
+    OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Copy the per-client counters into housekeeping                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ServiceGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+    memcpy(Hk->DecodeClient, HUFF_APP_ServiceData.Client, sizeof(Hk->DecodeClient));
+    Hk->DecodeUntrackedRequests = HUFF_APP_ServiceData.UntrackedRequests;
+    OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Clear the per-client counters                                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_ServiceResetStats(void)
+{
+    OS_MutSemTake(HUFF_APP_ServiceData.Mutex);
+    memset(HUFF_APP_ServiceData.Client, 0, sizeof(HUFF_APP_ServiceData.Client));
+    HUFF_APP_ServiceData.UntrackedRequests = 0;
+    OS_MutSemGive(HUFF_APP_ServiceData.Mutex);
+}
@@ -0,0 +1,125 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App input-size sweep.
+ *
+ *   The current input (corpus or generated) is decoded over a geometric
+ *   series of prefix lengths, so that the working set of the decoder moves
+ *   from L1-resident to DRAM-resident. Every prefix of the encoded stream
+ *   decodes to the same prefix of the input, so a single encoding serves all
+ *   sizes and nothing is allocated while sweeping.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_eventids.h"
+#include "huff_app_exec.h"
+#include "huff_app_sweep.h"
+#include "huff_app_utils.h"
+#include "huff_app_workload.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Report one size of the sweep                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_SweepReport(const HUFF_APP_Workload_t *Workload, size_t Length,
+                                 const HUFF_APP_DecodeResult_t *Result, int64 StartMicros)
+{
+    HUFF_APP_Report_t Report;
+    uint64            EncodedBytes;
+
+    /* Encoded bytes read by the prefix, from the average code length */
+    EncodedBytes = ((uint64)Workload->EncodedBytes * Length) / Workload->Length;
+
+    HUFF_APP_ReportInit(&Report, "$HUSW");
+    HUFF_APP_ReportAddU32(&Report, StartMicros / 1000);
+    HUFF_APP_ReportAddBuildId(&Report);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_Data.InputMode);
+    HUFF_APP_ReportAddU32(&Report, Length);
+    HUFF_APP_ReportAddU32(&Report, EncodedBytes);
+    HUFF_APP_ReportAddU32(&Report, Result->Iterations);
+    HUFF_APP_ReportAddU32(&Report, Result->DurationMicros);
+    HUFF_APP_ReportAddHexU32(&Report, Result->Status);
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultKiloBytesPerSec(Result));
+    HUFF_APP_ReportAddU32(&Report, HUFF_APP_ResultPicosPerSymbol(Result));
+    HUFF_APP_ReportSend(&Report);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode the current input at sizes MinBytes, 2 x MinBytes, ... up to        */
+/* MaxBytes, emitting one record per size                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_SweepRun(uint32 MinBytes, uint32 MaxBytes)
+{
+    const HUFF_APP_Workload_t *Workload;
+    HUFF_APP_DecodeResult_t    Result;
+    CFE_Status_t               status = CFE_SUCCESS;
+    int64                      StartMicros;
+    uint32                     Sizes = 0;
+    size_t                     Length;
+
+    Workload = HUFF_APP_WorkloadCurrent();
+    if (Workload == NULL)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_SWEEP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Sweep needs a corpus or generated input");
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    if (MinBytes == 0)
+    {
+        MinBytes = HUFF_APP_SWEEP_MIN_BYTES;
+    }
+    if (MaxBytes == 0 || MaxBytes > Workload->Length)
+    {
+        MaxBytes = Workload->Length;
+    }
+    if (MinBytes > MaxBytes)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_SWEEP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Invalid sweep: Min = %lu, Max = %lu, Input = %lu", (unsigned long)MinBytes,
+                          (unsigned long)MaxBytes, (unsigned long)Workload->Length);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    for (Length = MinBytes; Length <= MaxBytes && !HUFF_APP_ExecCancelled(); Length *= 2)
+    {
+        StartMicros = HUFF_APP_GetTimeMicros();
+        HUFF_APP_WorkloadMeasure(Workload, Length, HUFF_APP_WorkloadOutBuf, &Result);
+        HUFF_APP_SweepReport(Workload, Length, &Result, StartMicros);
+
+        if (Result.Status != CFE_SUCCESS && status == CFE_SUCCESS)
+        {
+            status = Result.Status;
+        }
+        Sizes++;
+    }
+
+    CFE_EVS_SendEvent(HUFF_APP_SWEEP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Sweep of %lu sizes from %lu to %lu bytes done, RC = 0x%08lX", (unsigned long)Sizes,
+                      (unsigned long)MinBytes, (unsigned long)MaxBytes, (unsigned long)status);
+
+    return status;
+}
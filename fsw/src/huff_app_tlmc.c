@@ -0,0 +1,465 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App telemetry compression.
+ *
+ *   The telemetry compression table lists MIDs to subscribe to on a pipe of
+ *   their own. Each wakeup drains that pipe until it is empty or the CPU
+ *   budget of the table is spent. The payload of each packet is encoded
+ *   with the static book of its MID, or a book rebuilt from the payloads
+ *   seen so far, and republished on HUFF_APP_TLMC_TLM_MID after the
+ *   original header. Adaptive books are sent along with the data when they
+ *   change and then periodically. A payload that does not shrink is sent
+ *   stored.
+ */
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+
+#include "huff_app.h"
+#include "huff_app_bookcache.h"
+#include "huff_app_codec.h"
+#include "huff_app_eventids.h"
+#include "huff_app_tbl.h"
+#include "huff_app_tlmc.h"
+#include "huff_app_utils.h"
+
+/* Bytes of a code book sent in a packet: code lengths, two per byte */
+#define HUFF_APP_TLMC_BOOK_BYTES (HUFF_APP_CODEC_SYMBOLS / 2)
+
+typedef struct
+{
+    CFE_SB_MsgId_t           MsgId;
+    HUFF_APP_TlmcBook_Enum_t BookMode;
+
+    HUFF_APP_CodeBook_t Book;
+    bool                BookValid;
+    uint16              Generation;   /* Incremented whenever the book changes */
+    uint32              SinceBook;    /* Packets since the book was last sent */
+    uint32              SinceAdapt;   /* Packets since the adaptive book was rebuilt */
+    uint32              Hist[HUFF_APP_CODEC_SYMBOLS];
+
+    HUFF_APP_TlmcMidTlm_t Stats;
+} HUFF_APP_TlmcMid_t;
+
+typedef struct
+{
+    CFE_TBL_Handle_t TblHandle;
+    CFE_SB_PipeId_t  Pipe;
+    uint32           CpuBudgetMicros;
+
+    HUFF_APP_TlmcMid_t Mid[HUFF_APP_TLMC_MAX_MIDS];
+    uint32             NumMids;
+    uint32             BudgetOverruns;
+    uint32             DroppedPackets;
+
+    HUFF_APP_TlmcTlm_t OutTlm;
+} HUFF_APP_TlmcData_t;
+
+static HUFF_APP_TlmcData_t HUFF_APP_TlmcData;
+
+extern HUFF_APP_TlmcTable_t HUFF_APP_TlmcDefaultTable;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Verify the telemetry compression table contents                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HUFF_APP_TlmcValidationFunc(void *TblData)
+{
+    const HUFF_APP_TlmcTable_t *TblDataPtr = (const HUFF_APP_TlmcTable_t *)TblData;
+    const HUFF_APP_TlmcEntry_t *Entry;
+    HUFF_APP_CodeBook_t         Book;
+    uint32                      i;
+
+    if (TblDataPtr->CpuBudgetMicros == 0)
+    {
+        return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    for (i = 0; i < HUFF_APP_TLMC_MAX_MIDS; i++)
+    {
+        Entry = &TblDataPtr->Entry[i];
+        if (Entry->MsgId == 0)
+        {
+            continue;
+        }
+
+        /* Compressing our own output would feed it back forever */
+        if (Entry->MsgId == HUFF_APP_TLMC_TLM_MID || Entry->BookMode > HUFF_APP_TlmcBook_STATIC)
+        {
+            return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+
+        if (Entry->BookMode == HUFF_APP_TlmcBook_STATIC &&
+            HUFF_APP_CodecBuildCodeBook(Entry->Lengths, &Book) != CFE_SUCCESS)
+        {
+            return HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Resubscribe to the MIDs of the current table, starting them afresh         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TlmcApplyTable(void)
+{
+    HUFF_APP_TlmcTable_t *      Table = NULL;
+    const HUFF_APP_TlmcEntry_t *Entry;
+    HUFF_APP_TlmcMid_t *        Mid;
+    CFE_Status_t                status;
+    uint32                      i;
+
+    for (i = 0; i < HUFF_APP_TlmcData.NumMids; i++)
+    {
+        CFE_SB_Unsubscribe(HUFF_APP_TlmcData.Mid[i].MsgId, HUFF_APP_TlmcData.Pipe);
+    }
+    memset(HUFF_APP_TlmcData.Mid, 0, sizeof(HUFF_APP_TlmcData.Mid));
+    HUFF_APP_TlmcData.NumMids = 0;
+
+    status = CFE_TBL_GetAddress((void **)&Table, HUFF_APP_TlmcData.TblHandle);
+    if (status != CFE_SUCCESS && status != CFE_TBL_INFO_UPDATED)
+    {
+        CFE_EVS_SendEvent(HUFF_APP_TLMC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "HUFF: Failed to get telemetry compression table, RC = 0x%08lX", (unsigned long)status);
+        return;
+    }
+
+    HUFF_APP_TlmcData.CpuBudgetMicros = Table->CpuBudgetMicros;
+
+    for (i = 0; i < HUFF_APP_TLMC_MAX_MIDS; i++)
+    {
+        Entry = &Table->Entry[i];
+        if (Entry->MsgId == 0)
+        {
+            continue;
+        }
+
+        Mid = &HUFF_APP_TlmcData.Mid[HUFF_APP_TlmcData.NumMids];
+        memset(Mid, 0, sizeof(*Mid));
+
+        Mid->MsgId       = CFE_SB_ValueToMsgId(Entry->MsgId);
+        Mid->BookMode    = Entry->BookMode;
+        Mid->SinceBook   = HUFF_APP_TLMC_BOOK_REPEAT;
+        Mid->Stats.MsgId = Entry->MsgId;
+
+        if (Entry->BookMode == HUFF_APP_TlmcBook_STATIC)
+        {
+            Mid->BookValid = (HUFF_APP_CodecBuildCodeBook(Entry->Lengths, &Mid->Book) == CFE_SUCCESS);
+        }
+
+        status = CFE_SB_Subscribe(Mid->MsgId, HUFF_APP_TlmcData.Pipe);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_TLMC_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Failed to subscribe to MID 0x%lx for compression, RC = 0x%08lX",
+                              (unsigned long)Entry->MsgId, (unsigned long)status);
+            continue;
+        }
+
+        HUFF_APP_TlmcData.NumMids++;
+    }
+
+    CFE_TBL_ReleaseAddress(HUFF_APP_TlmcData.TblHandle);
+
+    CFE_EVS_SendEvent(HUFF_APP_TLMC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "HUFF: Compressing %lu telemetry MIDs, budget %lu us per wakeup",
+                      (unsigned long)HUFF_APP_TlmcData.NumMids, (unsigned long)HUFF_APP_TlmcData.CpuBudgetMicros);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Account for a payload in an adaptive book, rebuilding it periodically      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TlmcAdapt(HUFF_APP_TlmcMid_t *Mid, const uint8 *Payload, size_t PayloadBytes)
+{
+    const HUFF_APP_BookCacheEntry_t *Cached;
+    uint32                           Smoothed[HUFF_APP_CODEC_SYMBOLS];
+    size_t                           i;
+
+    for (i = 0; i < PayloadBytes; i++)
+    {
+        Mid->Hist[Payload[i]]++;
+    }
+
+    if (Mid->BookValid && ++Mid->SinceAdapt < HUFF_APP_TLMC_ADAPT_PACKETS)
+    {
+        return;
+    }
+    Mid->SinceAdapt = 0;
+
+    /* Every symbol keeps a code, so that any later payload can be encoded; older packets fade out */
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        Smoothed[i] = Mid->Hist[i] + 1;
+        Mid->Hist[i] /= 2;
+    }
+
+    /* Periodic telemetry mostly maps to a book already built, often the current one */
+    Cached = HUFF_APP_BookCacheGet(Smoothed);
+    if (Cached == NULL)
+    {
+        return;
+    }
+
+    if (!Mid->BookValid || memcmp(Cached->Book.Lengths, Mid->Book.Lengths, sizeof(Mid->Book.Lengths)) != 0)
+    {
+        Mid->Book      = Cached->Book;
+        Mid->BookValid = true;
+        Mid->Generation++;
+        Mid->SinceBook = HUFF_APP_TLMC_BOOK_REPEAT;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Compress one subscribed packet and republish it                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TlmcCompress(HUFF_APP_TlmcMid_t *Mid, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    HUFF_APP_TlmcTlm_t *        Out     = &HUFF_APP_TlmcData.OutTlm;
+    HUFF_APP_TlmcTlm_Payload_t *OutData = &Out->Payload;
+    const uint8 *               Payload;
+    size_t                      MsgSize = 0;
+    size_t                      PayloadBytes;
+    size_t                      EncodedBytes = 0;
+    size_t                      BookBytes    = 0;
+    int64                       StartMicros;
+    uint32                      ElapsedMicros;
+    uint32                      i;
+    bool                        Encoded = false;
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &MsgSize);
+    if (MsgSize < sizeof(CFE_MSG_TelemetryHeader_t) ||
+        MsgSize - sizeof(CFE_MSG_TelemetryHeader_t) > HUFF_APP_TLMC_MAX_PAYLOAD)
+    {
+        HUFF_APP_TlmcData.DroppedPackets++;
+        return;
+    }
+
+    StartMicros  = HUFF_APP_GetTimeMicros();
+    Payload      = (const uint8 *)SBBufPtr + sizeof(CFE_MSG_TelemetryHeader_t);
+    PayloadBytes = MsgSize - sizeof(CFE_MSG_TelemetryHeader_t);
+
+    memcpy(&Out->OriginalHeader, SBBufPtr, sizeof(Out->OriginalHeader));
+
+    if (Mid->BookMode == HUFF_APP_TlmcBook_ADAPTIVE)
+    {
+        HUFF_APP_TlmcAdapt(Mid, Payload, PayloadBytes);
+    }
+
+    if (Mid->BookValid)
+    {
+        /* Static books are known from the table, only adaptive ones travel with the data */
+        if (Mid->BookMode == HUFF_APP_TlmcBook_ADAPTIVE && Mid->SinceBook >= HUFF_APP_TLMC_BOOK_REPEAT)
+        {
+            for (i = 0; i < HUFF_APP_TLMC_BOOK_BYTES; i++)
+            {
+                OutData->Data[i] = (Mid->Book.Lengths[2 * i] << 4) | Mid->Book.Lengths[2 * i + 1];
+            }
+            BookBytes = HUFF_APP_TLMC_BOOK_BYTES;
+        }
+
+        /* The book is amortized over the packets that use it, so only the data has to shrink */
+        Encoded = (HUFF_APP_CodecEncode(&Mid->Book, Payload, PayloadBytes, &OutData->Data[BookBytes],
+                                        PayloadBytes, &EncodedBytes) == CFE_SUCCESS &&
+                   EncodedBytes < PayloadBytes);
+    }
+
+    if (Encoded)
+    {
+        OutData->Flags     = 0;
+        OutData->DataBytes = BookBytes + EncodedBytes;
+        if (BookBytes != 0)
+        {
+            OutData->Flags |= HUFF_APP_TLMC_FLAG_BOOK;
+            Mid->SinceBook = 0;
+        }
+    }
+    else
+    {
+        memcpy(OutData->Data, Payload, PayloadBytes);
+        OutData->Flags     = HUFF_APP_TLMC_FLAG_STORED;
+        OutData->DataBytes = PayloadBytes;
+        Mid->Stats.StoredPackets++;
+    }
+
+    Mid->SinceBook++;
+    OutData->BookGeneration = Mid->Generation;
+    OutData->PayloadBytes   = PayloadBytes;
+
+    CFE_MSG_SetSize(CFE_MSG_PTR(Out->TelemetryHeader),
+                    offsetof(HUFF_APP_TlmcTlm_t, Payload.Data) + OutData->DataBytes);
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Out->TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Out->TelemetryHeader), true);
+
+    ElapsedMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+
+    Mid->Stats.Packets++;
+    Mid->Stats.PayloadBytes += PayloadBytes;
+    Mid->Stats.DataBytes += OutData->DataBytes;
+    Mid->Stats.EncodeMicros += ElapsedMicros;
+    if (ElapsedMicros > Mid->Stats.MaxEncodeMicros)
+    {
+        Mid->Stats.MaxEncodeMicros = (ElapsedMicros > 0xFFFF) ? 0xFFFF : ElapsedMicros;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Register the table, create the compression pipe and subscribe              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_TlmcInit(void)
+{
+    CFE_Status_t status;
+    os_fstat_t   TableStat;
+
+    memset(&HUFF_APP_TlmcData, 0, sizeof(HUFF_APP_TlmcData));
+
+    CFE_MSG_Init(CFE_MSG_PTR(HUFF_APP_TlmcData.OutTlm.TelemetryHeader), CFE_SB_ValueToMsgId(HUFF_APP_TLMC_TLM_MID),
+                 sizeof(HUFF_APP_TlmcData.OutTlm));
+
+    status = CFE_SB_CreatePipe(&HUFF_APP_TlmcData.Pipe, HUFF_APP_TLMC_PIPE_DEPTH, "HUFF_APP_TLMC_PIPE");
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    status = CFE_TBL_Register(&HUFF_APP_TlmcData.TblHandle, "TlmcTable", sizeof(HUFF_APP_TlmcTable_t),
+                              CFE_TBL_OPT_DEFAULT, HUFF_APP_TlmcValidationFunc);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    /* The mission table file when there is one, the built-in table otherwise */
+    if (OS_stat(HUFF_APP_TLMC_TABLE_FILE, &TableStat) == OS_SUCCESS)
+    {
+        status = CFE_TBL_Load(HUFF_APP_TlmcData.TblHandle, CFE_TBL_SRC_FILE, HUFF_APP_TLMC_TABLE_FILE);
+    }
+    else
+    {
+        status = CFE_TBL_Load(HUFF_APP_TlmcData.TblHandle, CFE_TBL_SRC_ADDRESS, &HUFF_APP_TlmcDefaultTable);
+    }
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    HUFF_APP_TlmcApplyTable();
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Compress the queued packets, within the CPU budget of a wakeup             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_TlmcWakeup(void)
+{
+    CFE_SB_Buffer_t *SBBufPtr;
+    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
+    int64            StartMicros;
+    uint32           i;
+
+    if (CFE_TBL_Manage(HUFF_APP_TlmcData.TblHandle) == CFE_TBL_INFO_UPDATED)
+    {
+        HUFF_APP_TlmcApplyTable();
+    }
+
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    while (CFE_SB_ReceiveBuffer(&SBBufPtr, HUFF_APP_TlmcData.Pipe, CFE_SB_POLL) == CFE_SUCCESS)
+    {
+        CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+
+        for (i = 0; i < HUFF_APP_TlmcData.NumMids; i++)
+        {
+            if (CFE_SB_MsgId_Equal(MsgId, HUFF_APP_TlmcData.Mid[i].MsgId))
+            {
+                HUFF_APP_TlmcCompress(&HUFF_APP_TlmcData.Mid[i], SBBufPtr);
+                break;
+            }
+        }
+
+        /* Leave the rest queued for the next wakeup */
+        if (HUFF_APP_GetTimeMicros() - StartMicros >= HUFF_APP_TlmcData.CpuBudgetMicros)
+        {
+            HUFF_APP_TlmcData.BudgetOverruns++;
+            break;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Copy the per-MID counters into housekeeping                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_TlmcGetStats(HUFF_APP_HkTlm_Payload_t *Hk)
+{
+    HUFF_APP_TlmcMidTlm_t *Stats;
+    uint32                 i;
+
+    memset(Hk->TlmcMid, 0, sizeof(Hk->TlmcMid));
+
+    for (i = 0; i < HUFF_APP_TlmcData.NumMids; i++)
+    {
+        Stats = &HUFF_APP_TlmcData.Mid[i].Stats;
+
+        Hk->TlmcMid[i] = *Stats;
+        if (Stats->PayloadBytes != 0)
+        {
+            Hk->TlmcMid[i].RatioPermille = ((uint64)Stats->DataBytes * 1000) / Stats->PayloadBytes;
+        }
+    }
+
+    Hk->TlmcBudgetOverruns = HUFF_APP_TlmcData.BudgetOverruns;
+    Hk->TlmcDroppedPackets = HUFF_APP_TlmcData.DroppedPackets;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Clear the per-MID counters                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_TlmcResetStats(void)
+{
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_TlmcData.NumMids; i++)
+    {
+        memset(&HUFF_APP_TlmcData.Mid[i].Stats, 0, sizeof(HUFF_APP_TlmcData.Mid[i].Stats));
+        HUFF_APP_TlmcData.Mid[i].Stats.MsgId = CFE_SB_MsgIdToValue(HUFF_APP_TlmcData.Mid[i].MsgId);
+    }
+
+    HUFF_APP_TlmcData.BudgetOverruns = 0;
+    HUFF_APP_TlmcData.DroppedPackets = 0;
+}
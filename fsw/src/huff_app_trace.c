@@ -0,0 +1,423 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App phase trace recorder.
+ *
+ *   Each traced task attaches a ring of the last HUFF_APP_TRACE_EVENTS begin
+ *   and end events of its phases, found from the OSAL index of the task.
+ *   Recording reads the PSP timebase, writes one slot and publishes the new
+ *   head with a release store, with no lock and no shared cache line. A
+ *   dump copies each ring and drops the events overwritten meanwhile.
+ *
+ *   Dumps are either Chrome trace-event JSON, or the raw events with a small
+ *   header, converted offline by tools/huff_trace2json.py:
+ *
+ *   - "HUTR", then uint32 version, timebase ticks per second, ring count
+ *   - per ring: char name[20], uint32 event count, then the events
+ *     (uint64 ticks, uint8 phase, uint8 kind, 6 spare bytes)
+ *
+ *   Integers are in the byte order of the target; the converter recognizes
+ *   it from the version field.
+ *
+ *   With HUFF_APP_TRACE_EVENTS set to 0 the recording macros expand to
+ *   nothing and the dump command is rejected.
+ */
+
+/*
+** Include Files:
+*/
+#include <stdio.h>
+
+#include "huff_app.h"
+#include "huff_app_trace.h"
+
+#if HUFF_APP_TRACE_EVENTS > 0
+
+#if (HUFF_APP_TRACE_EVENTS & (HUFF_APP_TRACE_EVENTS - 1)) != 0
+#error HUFF_APP_TRACE_EVENTS must be a power of two
+#endif
+
+#define HUFF_APP_TRACE_VERSION       1
+#define HUFF_APP_TRACE_NAME_LEN      20   /* Task name field of the binary format */
+#define HUFF_APP_TRACE_WRITE_SIZE    4096 /* Bytes buffered between file writes */
+
+typedef struct
+{
+    osal_id_t FileId;
+    int32     Status;
+    size_t    Used;
+    char      Buffer[HUFF_APP_TRACE_WRITE_SIZE];
+} HUFF_APP_TraceFile_t;
+
+typedef struct
+{
+    atomic_uint          Claimed; /* Rings handed out, may exceed the ring count */
+    HUFF_APP_TraceRing_t Ring[HUFF_APP_TRACE_MAX_TASKS];
+
+    /* Dump state, executor only */
+    HUFF_APP_TraceEvent_t Snapshot[HUFF_APP_TRACE_EVENTS];
+    HUFF_APP_TraceFile_t  File;
+} HUFF_APP_TraceData_t;
+
+static HUFF_APP_TraceData_t HUFF_APP_TraceData;
+
+HUFF_APP_TraceRing_t *HUFF_APP_TraceByTask[OS_MAX_TASKS];
+
+static const char *const HUFF_APP_TracePhaseName[HUFF_APP_TRACE_PHASES] = {
+    "receive", "dispatch", "generate", "decode", "verify", "format", "transmit"};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Give the calling task a ring. Tasks past HUFF_APP_TRACE_MAX_TASKS are not  */
+/* traced.                                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HUFF_APP_TraceAttach(const char *Name)
+{
+    HUFF_APP_TraceRing_t *Ring;
+    osal_id_t             TaskId = OS_TaskGetId();
+    osal_index_t          TaskIndex;
+    unsigned int          Slot;
+
+    if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, TaskId, &TaskIndex) != OS_SUCCESS)
+    {
+        return;
+    }
+
+    Slot = atomic_fetch_add(&HUFF_APP_TraceData.Claimed, 1);
+    if (Slot >= HUFF_APP_TRACE_MAX_TASKS)
+    {
+        return;
+    }
+
+    Ring         = &HUFF_APP_TraceData.Ring[Slot];
+    Ring->TaskId = TaskId;
+    strncpy(Ring->Name, Name, sizeof(Ring->Name) - 1);
+    atomic_store_explicit(&Ring->Attached, true, memory_order_release);
+
+    HUFF_APP_TraceByTask[TaskIndex] = Ring;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Copy the retained events of a ring into the snapshot. Returns the index    */
+/* of the first event still valid after the copy, and the count.             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint32 HUFF_APP_TraceCopy(HUFF_APP_TraceRing_t *Ring, uint32 *First)
+{
+    unsigned int Head;
+    unsigned int Later;
+    unsigned int Start;
+    unsigned int i;
+
+    Head  = atomic_load_explicit(&Ring->Head, memory_order_acquire);
+    Start = (Head > HUFF_APP_TRACE_EVENTS) ? Head - HUFF_APP_TRACE_EVENTS : 0;
+
+    for (i = Start; i != Head; i++)
+    {
+        HUFF_APP_TraceData.Snapshot[i - Start] = Ring->Event[i & (HUFF_APP_TRACE_EVENTS - 1)];
+    }
+
+    /*
+    ** The owning task kept recording: drop the slots it reused during the copy,
+    ** and the one of event Later, which it may be writing before publishing it
+    */
+    atomic_thread_fence(memory_order_acquire);
+    Later = atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+
+    *First = 0;
+    if (Later + 1 - Start > HUFF_APP_TRACE_EVENTS)
+    {
+        *First = Later + 1 - HUFF_APP_TRACE_EVENTS - Start;
+    }
+    if (*First > Head - Start)
+    {
+        *First = Head - Start;
+    }
+
+    return Head - Start;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Buffered file output. The first failure is kept and later writes skipped.  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TraceFlush(HUFF_APP_TraceFile_t *File)
+{
+    int32 OsStatus;
+
+    if (File->Used != 0 && File->Status == CFE_SUCCESS)
+    {
+        OsStatus = OS_write(File->FileId, File->Buffer, File->Used);
+        if (OsStatus != (int32)File->Used)
+        {
+            File->Status = CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+    }
+
+    File->Used = 0;
+}
+
+static void HUFF_APP_TraceWrite(HUFF_APP_TraceFile_t *File, const void *Data, size_t Size)
+{
+    const char *Bytes = Data;
+    size_t      Chunk;
+
+    while (Size > 0)
+    {
+        if (File->Used == sizeof(File->Buffer))
+        {
+            HUFF_APP_TraceFlush(File);
+        }
+
+        Chunk = sizeof(File->Buffer) - File->Used;
+        if (Chunk > Size)
+        {
+            Chunk = Size;
+        }
+
+        memcpy(&File->Buffer[File->Used], Bytes, Chunk);
+        File->Used += Chunk;
+        Bytes += Chunk;
+        Size -= Chunk;
+    }
+}
+
+static void HUFF_APP_TraceWriteText(HUFF_APP_TraceFile_t *File, const char *Text)
+{
+    HUFF_APP_TraceWrite(File, Text, strlen(Text));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Earliest retained event of all rings, the origin of the JSON timestamps    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint64 HUFF_APP_TraceOrigin(void)
+{
+    HUFF_APP_TraceRing_t *Ring;
+    unsigned int          Head;
+    unsigned int          Oldest;
+    uint64                Origin = UINT64_MAX;
+    uint64                Ticks;
+    uint32                i;
+
+    for (i = 0; i < HUFF_APP_TRACE_MAX_TASKS; i++)
+    {
+        Ring = &HUFF_APP_TraceData.Ring[i];
+        Head = atomic_load_explicit(&Ring->Head, memory_order_acquire);
+        if (!atomic_load_explicit(&Ring->Attached, memory_order_acquire) || Head == 0)
+        {
+            continue;
+        }
+
+        /* The oldest slot may be overwritten while read, it is only an origin */
+        Oldest = (Head > HUFF_APP_TRACE_EVENTS) ? Head - HUFF_APP_TRACE_EVENTS : 0;
+        Ticks  = Ring->Event[Oldest & (HUFF_APP_TRACE_EVENTS - 1)].Ticks;
+        if (Ticks < Origin)
+        {
+            Origin = Ticks;
+        }
+    }
+
+    return (Origin == UINT64_MAX) ? 0 : Origin;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Chrome trace-event JSON: one thread per ring, B and E events in            */
+/* microseconds from the earliest event                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TraceWriteJson(HUFF_APP_TraceFile_t *File, uint32 TicksPerSecond)
+{
+    const HUFF_APP_TraceEvent_t *Event;
+    HUFF_APP_TraceRing_t *       Ring;
+    char                         Line[160];
+    uint64                       Origin = HUFF_APP_TraceOrigin();
+    uint64                       Ticks;
+    uint64                       Nanos;
+    uint32                       Count;
+    uint32                       First;
+    uint32                       Depth;
+    uint32                       i;
+    uint32                       j;
+    int                          Len;
+
+    HUFF_APP_TraceWriteText(File, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    HUFF_APP_TraceWriteText(File,
+                            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"HUFF_APP\"}}");
+
+    for (i = 0; i < HUFF_APP_TRACE_MAX_TASKS; i++)
+    {
+        Ring = &HUFF_APP_TraceData.Ring[i];
+        if (!atomic_load_explicit(&Ring->Attached, memory_order_acquire))
+        {
+            continue;
+        }
+
+        Len = snprintf(Line, sizeof(Line),
+                       ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+                       (unsigned long)(i + 1), Ring->Name);
+        HUFF_APP_TraceWrite(File, Line, Len);
+
+        Count = HUFF_APP_TraceCopy(Ring, &First);
+        Depth = 0;
+
+        for (j = First; j < Count; j++)
+        {
+            Event = &HUFF_APP_TraceData.Snapshot[j];
+            if (Event->Phase >= HUFF_APP_TRACE_PHASES)
+            {
+                continue;
+            }
+
+            /* Ends of phases begun before the oldest retained event have no match */
+            if (Event->Kind == HUFF_APP_TRACE_KIND_END)
+            {
+                if (Depth == 0)
+                {
+                    continue;
+                }
+                Depth--;
+            }
+            else
+            {
+                Depth++;
+            }
+
+            Ticks = (Event->Ticks > Origin) ? Event->Ticks - Origin : 0;
+            Nanos = (Ticks / TicksPerSecond) * 1000000000ULL +
+                    ((Ticks % TicksPerSecond) * 1000000000ULL) / TicksPerSecond;
+
+            Len = snprintf(Line, sizeof(Line),
+                           ",\n{\"name\":\"%s\",\"cat\":\"huff\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%lu}",
+                           HUFF_APP_TracePhaseName[Event->Phase], (Event->Kind == HUFF_APP_TRACE_KIND_END) ? 'E' : 'B',
+                           (unsigned long long)(Nanos / 1000), (unsigned int)(Nanos % 1000), (unsigned long)(i + 1));
+            HUFF_APP_TraceWrite(File, Line, Len);
+        }
+    }
+
+    HUFF_APP_TraceWriteText(File, "\n]}\n");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Binary dump: header, then the raw events of each ring                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HUFF_APP_TraceWriteBinary(HUFF_APP_TraceFile_t *File, uint32 TicksPerSecond)
+{
+    HUFF_APP_TraceRing_t *Ring;
+    char                  Name[HUFF_APP_TRACE_NAME_LEN];
+    uint32                Header[3];
+    uint32                Rings = 0;
+    uint32                Count;
+    uint32                First;
+    uint32                i;
+
+    for (i = 0; i < HUFF_APP_TRACE_MAX_TASKS; i++)
+    {
+        Rings += atomic_load_explicit(&HUFF_APP_TraceData.Ring[i].Attached, memory_order_acquire);
+    }
+
+    Header[0] = HUFF_APP_TRACE_VERSION;
+    Header[1] = TicksPerSecond;
+    Header[2] = Rings;
+    HUFF_APP_TraceWriteText(File, "HUTR");
+    HUFF_APP_TraceWrite(File, Header, sizeof(Header));
+
+    for (i = 0; i < HUFF_APP_TRACE_MAX_TASKS && Rings > 0; i++)
+    {
+        Ring = &HUFF_APP_TraceData.Ring[i];
+        if (!atomic_load_explicit(&Ring->Attached, memory_order_acquire))
+        {
+            continue;
+        }
+
+        memset(Name, 0, sizeof(Name));
+        strncpy(Name, Ring->Name, sizeof(Name) - 1);
+
+        Count = HUFF_APP_TraceCopy(Ring, &First) - First;
+
+        HUFF_APP_TraceWrite(File, Name, sizeof(Name));
+        HUFF_APP_TraceWrite(File, &Count, sizeof(Count));
+        HUFF_APP_TraceWrite(File, &HUFF_APP_TraceData.Snapshot[First], Count * sizeof(HUFF_APP_TraceEvent_t));
+
+        Rings--;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Write the retained events of every ring to a file. Recording goes on.      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t HUFF_APP_TraceDump(const char *FileName, uint8 Format)
+{
+    HUFF_APP_TraceFile_t *File = &HUFF_APP_TraceData.File;
+    uint32                TicksPerSecond;
+    int32                 OsStatus;
+
+    if (Format != HUFF_APP_TraceFormat_JSON && Format != HUFF_APP_TraceFormat_BINARY)
+    {
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    TicksPerSecond = CFE_PSP_GetTimerTicksPerSecond();
+    if (TicksPerSecond == 0)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    OsStatus = OS_OpenCreate(&File->FileId, FileName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (OsStatus != OS_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    File->Status = CFE_SUCCESS;
+    File->Used   = 0;
+
+    if (Format == HUFF_APP_TraceFormat_JSON)
+    {
+        HUFF_APP_TraceWriteJson(File, TicksPerSecond);
+    }
+    else
+    {
+        HUFF_APP_TraceWriteBinary(File, TicksPerSecond);
+    }
+
+    HUFF_APP_TraceFlush(File);
+    OS_close(File->FileId);
+
+    return File->Status;
+}
+
+#else /* HUFF_APP_TRACE_EVENTS > 0 */
+
+CFE_Status_t HUFF_APP_TraceDump(const char *FileName, uint8 Format)
+{
+    return CFE_STATUS_NOT_IMPLEMENTED;
+}
+
+#endif
@@ -0,0 +1,127 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App phase trace recorder
+ */
+
+#ifndef HUFF_APP_TRACE_H
+#define HUFF_APP_TRACE_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_utils.h"
+
+/*
+** Traced phases, in the order of their names in the dump
+*/
+enum
+{
+    HUFF_APP_TRACE_RECEIVE  = 0, /* Pending on a pipe */
+    HUFF_APP_TRACE_DISPATCH = 1, /* Handling one message or benchmark command */
+    HUFF_APP_TRACE_GENERATE = 2, /* Generating and encoding an input */
+    HUFF_APP_TRACE_DECODE   = 3,
+    HUFF_APP_TRACE_VERIFY   = 4, /* Comparing the decoded output with the input */
+    HUFF_APP_TRACE_FORMAT   = 5, /* Building a result sentence */
+    HUFF_APP_TRACE_TRANSMIT = 6,
+    HUFF_APP_TRACE_PHASES   = 7
+};
+
+#define HUFF_APP_TRACE_KIND_BEGIN 0
+#define HUFF_APP_TRACE_KIND_END   1
+
+#if HUFF_APP_TRACE_EVENTS > 0
+
+#include <stdatomic.h>
+
+/*
+** One event, also the record of the binary dump format
+*/
+typedef struct
+{
+    uint64 Ticks; /* HUFF_APP_GetTimebaseTicks() */
+    uint8  Phase;
+    uint8  Kind;
+    uint8  spare[6];
+} HUFF_APP_TraceEvent_t;
+
+/*
+** Ring of the last events of one task. Only the owning task writes it.
+*/
+typedef struct
+{
+    atomic_uint           Head;     /* Events recorded so far */
+    atomic_bool           Attached; /* Set once Name is valid */
+    osal_id_t             TaskId;   /* Owning task */
+    char                  Name[OS_MAX_API_NAME];
+    HUFF_APP_TraceEvent_t Event[HUFF_APP_TRACE_EVENTS];
+} HUFF_APP_TraceRing_t;
+
+/*
+** Ring of each traced task, by the OSAL array index of the task. A task that
+** reuses the index of an exited one is only traced once it attaches itself.
+*/
+extern HUFF_APP_TraceRing_t *HUFF_APP_TraceByTask[OS_MAX_TASKS];
+
+static inline void HUFF_APP_TraceRecord(uint8 Phase, uint8 Kind)
+{
+    HUFF_APP_TraceRing_t * Ring;
+    HUFF_APP_TraceEvent_t *Event;
+    osal_id_t              TaskId = OS_TaskGetId();
+    osal_index_t           TaskIndex;
+    unsigned int           Head;
+
+    if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, TaskId, &TaskIndex) != OS_SUCCESS)
+    {
+        return;
+    }
+
+    Ring = HUFF_APP_TraceByTask[TaskIndex];
+    if (Ring == NULL || !OS_ObjectIdEqual(Ring->TaskId, TaskId))
+    {
+        return;
+    }
+
+    Head         = atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+    Event        = &Ring->Event[Head & (HUFF_APP_TRACE_EVENTS - 1)];
+    Event->Ticks = HUFF_APP_GetTimebaseTicks();
+    Event->Phase = Phase;
+    Event->Kind  = Kind;
+
+    atomic_store_explicit(&Ring->Head, Head + 1, memory_order_release);
+}
+
+#define HUFF_APP_TRACE_BEGIN(Phase) HUFF_APP_TraceRecord((Phase), HUFF_APP_TRACE_KIND_BEGIN)
+#define HUFF_APP_TRACE_END(Phase)   HUFF_APP_TraceRecord((Phase), HUFF_APP_TRACE_KIND_END)
+
+void HUFF_APP_TraceAttach(const char *Name);
+
+#else
+
+#define HUFF_APP_TRACE_BEGIN(Phase) ((void)0)
+#define HUFF_APP_TRACE_END(Phase)   ((void)0)
+#define HUFF_APP_TraceAttach(Name)  ((void)0)
+
+#endif
+
+CFE_Status_t HUFF_APP_TraceDump(const char *FileName, uint8 Format);
+
+#endif /* HUFF_APP_TRACE_H */
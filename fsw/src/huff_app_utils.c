@@ -25,32 +25,127 @@
 ** Include Files:
 */
 #include "huff_app.h"
+#include "huff_app_codec.h"
 #include "huff_app_eventids.h"
+#include "huff_app_service.h"
 #include "huff_app_tbl.h"
+#include "huff_app_trace.h"
 #include "huff_app_utils.h"
 
+/* The bench_lib module provides the report formatting helpers */
+#include "bench_lib.h"
+
+/*
+** Two-sided 95% Student t quantiles, in thousandths, for 1 to 30 degrees of freedom
+*/
+static const uint16 HUFF_APP_StudentT95[30] = {12706, 4303, 3182, 2776, 2571, 2447, 2365, 2306, 2262, 2228,
+                                               2201,  2179, 2160, 2145, 2131, 2120, 2110, 2101, 2093, 2086,
+                                               2080,  2074, 2069, 2064, 2060, 2056, 2052, 2048, 2045, 2042};
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
-/* Verify contents of First Example Table buffer contents                  */
+/* Verify contents of the Code Book Table buffer contents          */
 /*                                                                 */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 int32 HUFF_APP_TblValidationFunc(void *TblData)
 {
-    int32                      ReturnCode = CFE_SUCCESS;
-    HUFF_APP_ExampleTable_t *TblDataPtr = (HUFF_APP_ExampleTable_t *)TblData;
+    int32                 ReturnCode = CFE_SUCCESS;
+    HUFF_APP_BookTable_t *TblDataPtr = (HUFF_APP_BookTable_t *)TblData;
+    HUFF_APP_CodeBook_t   Book;
+    uint32                i;
 
     /*
-    ** Sample Example Table Validation
+    ** Every book must be a prefix code within the decode table size (Kraft inequality)
     */
-    if (TblDataPtr->Int1 > HUFF_APP_TBL_ELEMENT_1_MAX)
+    for (i = 0; i < HUFF_APP_TBL_MAX_BOOKS; i++)
     {
-        /* First element is out of range, return an appropriate error code */
-        ReturnCode = HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        if (HUFF_APP_CodecBuildCodeBook(TblDataPtr->Book[i].Lengths, &Book) != CFE_SUCCESS)
+        {
+            ReturnCode = HUFF_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
     }
 
     return ReturnCode;
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Build the decode tables of the pending Code Book Table books    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_TblApplyBooks(void)
+{
+    HUFF_APP_BookTable_t *TblDataPtr = NULL;
+    HUFF_APP_CodeBook_t   Book;
+    int32                 status;
+    uint32                Loaded  = 0;
+    uint32                Cleared = 0;
+    uint32                i;
+    uint32                j;
+    bool                  Used;
+
+    status = CFE_TBL_GetAddress((void **)&TblDataPtr, HUFF_APP_Data.TblHandles[0]);
+    if (status != CFE_SUCCESS && status != CFE_TBL_INFO_UPDATED)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: Error Getting Code Book Table Address, RC = 0x%08lX\n",
+                             (unsigned long)status);
+        return;
+    }
+
+    for (i = 0; i < HUFF_APP_TBL_MAX_BOOKS; i++)
+    {
+        if ((HUFF_APP_Data.TblBooksPending & (1u << i)) == 0)
+        {
+            continue;
+        }
+
+        Used = false;
+        for (j = 0; j < HUFF_APP_CODEC_SYMBOLS; j++)
+        {
+            Used |= (TblDataPtr->Book[i].Lengths[j] != 0);
+        }
+
+        if (Used && HUFF_APP_CodecBuildCodeBook(TblDataPtr->Book[i].Lengths, &Book) == CFE_SUCCESS)
+        {
+            status = HUFF_APP_ServiceSetBook(1 + i, &Book);
+            if (status == CFE_SUCCESS)
+            {
+                Loaded++;
+            }
+        }
+        else
+        {
+            status = HUFF_APP_ServiceSetBook(1 + i, NULL);
+            if (status == CFE_SUCCESS)
+            {
+                Cleared++;
+            }
+        }
+
+        /*
+        ** Decodes still hold the spare bank: the book and the ones after it
+        ** stay pending for the next HK cycle, so HK waits for one timeout at most
+        */
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(HUFF_APP_SERVICE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "HUFF: Code book %lu still in use, retried at next HK, RC = 0x%08lX",
+                              (unsigned long)(1 + i), (unsigned long)status);
+            break;
+        }
+
+        HUFF_APP_Data.TblBooksPending &= ~(1u << i);
+    }
+
+    CFE_TBL_ReleaseAddress(HUFF_APP_Data.TblHandles[0]);
+
+    if (Loaded != 0 || Cleared != 0)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: %lu code books loaded, %lu cleared from the Code Book Table\n",
+                             (unsigned long)Loaded, (unsigned long)Cleared);
+    }
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
 /* Output CRC                                                      */
@@ -65,7 +160,7 @@ void HUFF_APP_GetCrc(const char *TableName)
     status = CFE_TBL_GetInfo(&TblInfoPtr, TableName);
     if (status != CFE_SUCCESS)
     {
-        CFE_ES_WriteToSysLog("HUFF App: Error Getting Example Table Info");
+        CFE_ES_WriteToSysLog("HUFF App: Error Getting Table Info");
     }
     else
     {
@@ -73,3 +168,226 @@ void HUFF_APP_GetCrc(const char *TableName)
         CFE_ES_WriteToSysLog("HUFF App: CRC: 0x%08lX\n\n", (unsigned long)Crc);
     }
 }
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Current PSP time in microseconds                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int64 HUFF_APP_GetTimeMicros(void)
+{
+    OS_time_t LocalTime;
+
+    memset(&LocalTime, 0, sizeof(LocalTime));
+    CFE_PSP_GetTime(&LocalTime);
+
+    return OS_TimeGetTotalMicroseconds(LocalTime);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Current PSP timebase, in CFE_PSP_GetTimerTicksPerSecond() ticks */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 HUFF_APP_GetTimebaseTicks(void)
+{
+    uint32 Tbu;
+    uint32 Tbl;
+    uint32 Rollover = CFE_PSP_GetTimerLow32Rollover();
+
+    CFE_PSP_Get_Timebase(&Tbu, &Tbl);
+
+    /* The lower word wraps at Rollover, e.g. nanoseconds on pc-linux; 0 means at 2^32 */
+    if (Rollover == 0)
+    {
+        return ((uint64)Tbu << 32) | Tbl;
+    }
+
+    return (uint64)Tbu * Rollover + Tbl;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Median of Count values, sorting them in place                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 HUFF_APP_MedianU32(uint32 *Values, uint32 Count)
+{
+    uint32 Value;
+    uint32 i;
+    uint32 j;
+
+    /* Insertion sort: callers pass at most a few hundred samples */
+    for (i = 1; i < Count; i++)
+    {
+        Value = Values[i];
+        for (j = i; j > 0 && Values[j - 1] > Value; j--)
+        {
+            Values[j] = Values[j - 1];
+        }
+        Values[j] = Value;
+    }
+
+    if ((Count & 1) == 0)
+    {
+        return (uint32)(((uint64)Values[Count / 2 - 1] + Values[Count / 2]) / 2);
+    }
+
+    return Values[Count / 2];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Two-sided 95% Student t quantile for Df degrees of freedom,    */
+/* in thousandths                                                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 HUFF_APP_StudentT95Milli(uint32 Df)
+{
+    if (Df <= 30)
+    {
+        return HUFF_APP_StudentT95[(Df > 0) ? Df - 1 : 0];
+    }
+    if (Df <= 60)
+    {
+        return 2000;
+    }
+    if (Df <= 120)
+    {
+        return 1980;
+    }
+
+    return 1960;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Result sentence formatting                                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_ReportInit(HUFF_APP_Report_t *Report, const char *Tag)
+{
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_FORMAT);
+
+    strncpy(Report->Text, Tag, sizeof(Report->Text));
+    Report->Text[sizeof(Report->Text) - 1] = '\0';
+}
+
+static void HUFF_APP_ReportAppend(HUFF_APP_Report_t *Report, const char *Separator, const uint8 *Field)
+{
+    size_t Used = strlen(Report->Text);
+
+    strncat(Report->Text, Separator, sizeof(Report->Text) - Used - 1);
+    Used = strlen(Report->Text);
+    strncat(Report->Text, (const char *)Field, sizeof(Report->Text) - Used - 1);
+}
+
+void HUFF_APP_ReportAddU32(HUFF_APP_Report_t *Report, uint32 Value)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintU32(PrintBuffer, Value);
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+}
+
+void HUFF_APP_ReportAddS32(HUFF_APP_Report_t *Report, int32 Value)
+{
+    uint8 PrintBuffer[16];
+
+    PrintBuffer[0] = '-';
+    BENCH_LIB_vPrintU32(&PrintBuffer[Value < 0], (Value < 0) ? (uint32)0 - (uint32)Value : (uint32)Value);
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+}
+
+void HUFF_APP_ReportAddHexU8(HUFF_APP_Report_t *Report, uint8 Value)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintHexU8(PrintBuffer, Value);
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+}
+
+void HUFF_APP_ReportAddHexU16(HUFF_APP_Report_t *Report, uint16 Value)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintHexU16(PrintBuffer, Value);
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+}
+
+void HUFF_APP_ReportAddHexU32(HUFF_APP_Report_t *Report, uint32 Value)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintHexU32(PrintBuffer, Value);
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+}
+
+void HUFF_APP_ReportAddHexU64(HUFF_APP_Report_t *Report, uint64 Value)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintHexU32(PrintBuffer, (uint32)(Value >> 32));
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+    BENCH_LIB_vPrintHexU32(PrintBuffer, (uint32)Value);
+    HUFF_APP_ReportAppend(Report, "", PrintBuffer);
+}
+
+/*
+** Compiler debug flags and machine cache settings, as "FF-CC"
+*/
+void HUFF_APP_ReportAddBuildId(HUFF_APP_Report_t *Report)
+{
+    uint8 PrintBuffer[16];
+
+    BENCH_LIB_vPrintHexU8(PrintBuffer, BENCH_LIB_u8BuildFlags());
+    HUFF_APP_ReportAppend(Report, ",", PrintBuffer);
+    BENCH_LIB_vPrintHexU8(PrintBuffer, BENCH_LIB_u8GetCacheSettings());
+    HUFF_APP_ReportAppend(Report, "-", PrintBuffer);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Terminate the sentence with its checksum and send it in the     */
+/* result telemetry packet                                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_ReportSend(HUFF_APP_Report_t *Report)
+{
+    int32 status;
+    char  Checksum[3];
+
+    HUFF_APP_ReportAppend(Report, "*", (const uint8 *)"");
+
+    BENCH_LIB_pcGenerateChecksum(Report->Text, Checksum);
+    Checksum[2] = 0;
+    HUFF_APP_ReportAppend(Report, "", (const uint8 *)Checksum);
+
+    status = CFE_SB_MessageStringSet(HUFF_APP_Data.ResultTlm.Payload.ResultStr, Report->Text,
+                                     sizeof(HUFF_APP_Data.ResultTlm.Payload.ResultStr), sizeof(Report->Text));
+    if (status == CFE_SB_BAD_ARGUMENT)
+    {
+        CFE_ES_WriteToSysLog("HUFF App: Fail to post result: 0x%08lx", (unsigned long)status);
+    }
+    HUFF_APP_Data.ResultTlm.Payload.ResultStr[sizeof(HUFF_APP_Data.ResultTlm.Payload.ResultStr) - 1] = '\0';
+
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_FORMAT);
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_TRANSMIT);
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(HUFF_APP_Data.ResultTlm.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(HUFF_APP_Data.ResultTlm.TelemetryHeader), true /* IsOrigination: fix sequence, timestamp etc. */);
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_TRANSMIT);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Pause a dump after every burst of Sent sentences                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HUFF_APP_ReportPace(uint32 Sent)
+{
+    if (Sent % HUFF_APP_EXEC_DUMP_BURST == 0)
+    {
+        OS_TaskDelay(HUFF_APP_EXEC_DUMP_PAUSE_MS);
+    }
+}
@@ -29,7 +29,35 @@
 */
 #include "huff_app.h"
 
+/*
+** Result sentence under construction: "$TAG,field,...,field*CS"
+*/
+typedef struct
+{
+    char Text[HUFF_APP_RESULT_STR_LEN];
+} HUFF_APP_Report_t;
+
+/* Every book of the Code Book Table, in HUFF_APP_Data.TblBooksPending */
+#define HUFF_APP_TBL_ALL_BOOKS ((1u << HUFF_APP_TBL_MAX_BOOKS) - 1)
+
 int32 HUFF_APP_TblValidationFunc(void *TblData);
+void  HUFF_APP_TblApplyBooks(void);
 void  HUFF_APP_GetCrc(const char *TableName);
 
+int64  HUFF_APP_GetTimeMicros(void);
+uint64 HUFF_APP_GetTimebaseTicks(void);
+uint32 HUFF_APP_MedianU32(uint32 *Values, uint32 Count);
+uint32 HUFF_APP_StudentT95Milli(uint32 Df);
+
+void HUFF_APP_ReportInit(HUFF_APP_Report_t *Report, const char *Tag);
+void HUFF_APP_ReportAddU32(HUFF_APP_Report_t *Report, uint32 Value);
+void HUFF_APP_ReportAddS32(HUFF_APP_Report_t *Report, int32 Value);
+void HUFF_APP_ReportAddHexU8(HUFF_APP_Report_t *Report, uint8 Value);
+void HUFF_APP_ReportAddHexU16(HUFF_APP_Report_t *Report, uint16 Value);
+void HUFF_APP_ReportAddHexU32(HUFF_APP_Report_t *Report, uint32 Value);
+void HUFF_APP_ReportAddHexU64(HUFF_APP_Report_t *Report, uint64 Value);
+void HUFF_APP_ReportAddBuildId(HUFF_APP_Report_t *Report);
+void HUFF_APP_ReportSend(HUFF_APP_Report_t *Report);
+void HUFF_APP_ReportPace(uint32 Sent);
+
 #endif /* HUFF_APP_UTILS_H */
\ No newline at end of file
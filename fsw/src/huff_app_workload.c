@@ -0,0 +1,240 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the HUFF App in-app decode workloads.
+ *
+ *   A workload is prepared once (histogram, code book, decode table and
+ *   encoding, all outside any timed region) and then decoded repeatedly.
+ */
+
+/*
+** Include Files:
+*/
+#include "huff_app.h"
+#include "huff_app_corpus.h"
+#include "huff_app_gen.h"
+#include "huff_app_runstat.h"
+#include "huff_app_trace.h"
+#include "huff_app_workload.h"
+#include "huff_app_utils.h"
+
+uint8  HUFF_APP_WorkloadSrcBuf[HUFF_APP_WORKLOAD_MAX_BYTES];
+uint8  HUFF_APP_WorkloadEncBuf[HUFF_APP_WORKLOAD_ENC_BYTES];
+uint8  HUFF_APP_WorkloadOutBuf[HUFF_APP_WORKLOAD_MAX_BYTES];
+uint32 HUFF_APP_WorkloadIndexBuf[HUFF_APP_WORKLOAD_INDEX_ENTRIES];
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Build the code book of an input, encode it and index its blocks           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_WorkloadPrepare(HUFF_APP_Workload_t *Workload, const uint8 *Src, size_t Length, uint8 *Enc,
+                               size_t EncSize, uint32 *Index, size_t IndexEntries)
+{
+    uint8 Lengths[HUFF_APP_CODEC_SYMBOLS];
+    int32 status;
+
+    Workload->Valid        = false;
+    Workload->Src          = Src;
+    Workload->Length       = Length;
+    Workload->Enc          = Enc;
+    Workload->EncodedBytes = 0;
+    Workload->Index        = Index;
+    Workload->IndexEntries = 0;
+
+    HUFF_APP_CodecHistogram(Src, Length, Workload->Hist);
+    HUFF_APP_CodecBuildLengths(Workload->Hist, Lengths);
+
+    status = HUFF_APP_CodecBuildCodeBook(Lengths, &Workload->Book);
+    if (status == CFE_SUCCESS)
+    {
+        HUFF_APP_CodecBuildDecodeTable(&Workload->Book, &Workload->Table);
+        status = HUFF_APP_CodecEncode(&Workload->Book, Src, Length, Enc, EncSize, &Workload->EncodedBytes);
+    }
+    if (status == CFE_SUCCESS && Length > 0)
+    {
+        Workload->IndexEntries = HUFF_APP_CodecBuildIndex(&Workload->Book, Src, Length,
+                                                          HUFF_APP_WORKLOAD_BLOCK_SYMBOLS, Index, IndexEntries);
+        if (Workload->IndexEntries == 0)
+        {
+            status = CFE_STATUS_RANGE_ERROR;
+        }
+    }
+
+    Workload->Valid = (status == CFE_SUCCESS);
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Workload of the current input mode, NULL when it has none                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const HUFF_APP_Workload_t *HUFF_APP_WorkloadCurrent(void)
+{
+    const HUFF_APP_Workload_t *Workload;
+
+    switch (HUFF_APP_Data.InputMode)
+    {
+        case HUFF_APP_InputMode_CORPUS:
+            Workload = HUFF_APP_CorpusWorkload();
+            break;
+
+        case HUFF_APP_InputMode_GEN:
+            Workload = HUFF_APP_GenWorkload();
+            break;
+
+        default:
+            Workload = NULL;
+            break;
+    }
+
+    if (Workload != NULL && !Workload->Valid)
+    {
+        Workload = NULL;
+    }
+
+    return Workload;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode the first Length symbols of a workload Result->Iterations times in  */
+/* one timed sample, with the table or the bit-serial decoder, then verify    */
+/* the output against the original input                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 HUFF_APP_WorkloadDecodeWith(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                                         HUFF_APP_DecodeResult_t *Result, bool Serial)
+{
+    int64  StartMicros;
+    int32  status;
+    uint32 i;
+
+    Result->Status = CFE_SUCCESS;
+    if (Result->Iterations == 0)
+    {
+        Result->Iterations = 1;
+    }
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_DECODE);
+    StartMicros = HUFF_APP_GetTimeMicros();
+
+    for (i = 0; i < Result->Iterations; i++)
+    {
+        if (Serial)
+        {
+            status = HUFF_APP_CodecDecodeSerial(&Workload->Book, Workload->Enc, Workload->EncodedBytes, Out, Length);
+        }
+        else
+        {
+            status = HUFF_APP_CodecDecode(&Workload->Table, Workload->Enc, Workload->EncodedBytes, Out, Length);
+        }
+        if (status != CFE_SUCCESS && Result->Status == CFE_SUCCESS)
+        {
+            Result->Status = status;
+        }
+    }
+
+    Result->DurationMicros = HUFF_APP_GetTimeMicros() - StartMicros;
+    Result->Symbols        = (uint64)Length * Result->Iterations;
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_DECODE);
+
+    /* One output byte per symbol */
+    HUFF_APP_RunStatDecoded(Result->Symbols, Result->Symbols);
+
+    HUFF_APP_TRACE_BEGIN(HUFF_APP_TRACE_VERIFY);
+    if (Result->Status == CFE_SUCCESS && memcmp(Out, Workload->Src, Length) != 0)
+    {
+        Result->Status = CFE_STATUS_VALIDATION_FAILURE;
+    }
+    HUFF_APP_TRACE_END(HUFF_APP_TRACE_VERIFY);
+
+    return Result->Status;
+}
+
+int32 HUFF_APP_WorkloadDecode(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                              HUFF_APP_DecodeResult_t *Result)
+{
+    return HUFF_APP_WorkloadDecodeWith(Workload, Length, Out, Result, false);
+}
+
+int32 HUFF_APP_WorkloadDecodeSerial(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                                    HUFF_APP_DecodeResult_t *Result)
+{
+    return HUFF_APP_WorkloadDecodeWith(Workload, Length, Out, Result, true);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Timed decode, with the iteration count doubled until the sample lasts at   */
+/* least the calibrated minimum sample time                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HUFF_APP_WorkloadMeasure(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                               HUFF_APP_DecodeResult_t *Result)
+{
+    uint32 Iterations = 1;
+
+    while (true)
+    {
+        Result->Iterations = Iterations;
+        if (HUFF_APP_WorkloadDecode(Workload, Length, Out, Result) != CFE_SUCCESS ||
+            Result->DurationMicros >= HUFF_APP_Data.MinSampleMicros || Iterations >= HUFF_APP_CALIB_MAX_ITERATIONS)
+        {
+            break;
+        }
+
+        Iterations *= 2;
+    }
+
+    return Result->Status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode throughput in kB/s (1000 bytes per second, i.e. MB/s x 1000)        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_ResultKiloBytesPerSec(const HUFF_APP_DecodeResult_t *Result)
+{
+    if (Result->DurationMicros <= 0)
+    {
+        return 0;
+    }
+
+    return (uint32)((Result->Symbols * 1000) / (uint64)Result->DurationMicros);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Decode time per symbol in picoseconds (ns/symbol x 1000)                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HUFF_APP_ResultPicosPerSymbol(const HUFF_APP_DecodeResult_t *Result)
+{
+    if (Result->Symbols == 0)
+    {
+        return 0;
+    }
+
+    return (uint32)(((uint64)Result->DurationMicros * 1000000) / Result->Symbols);
+}
@@ -0,0 +1,91 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the HUFF App in-app decode workloads
+ */
+
+#ifndef HUFF_APP_WORKLOAD_H
+#define HUFF_APP_WORKLOAD_H
+
+/*
+** Required header files.
+*/
+#include "huff_app.h"
+#include "huff_app_codec.h"
+
+/* Worst case encoded size of a workload input */
+#define HUFF_APP_WORKLOAD_ENC_BYTES \
+    ((HUFF_APP_WORKLOAD_MAX_BYTES / 8) * HUFF_APP_CODEC_MAX_CODE_LEN + HUFF_APP_CODEC_MAX_CODE_LEN)
+
+/* Entries of the block index of the largest workload input */
+#define HUFF_APP_WORKLOAD_INDEX_ENTRIES \
+    ((HUFF_APP_WORKLOAD_MAX_BYTES + HUFF_APP_WORKLOAD_BLOCK_SYMBOLS - 1) / HUFF_APP_WORKLOAD_BLOCK_SYMBOLS)
+
+/*
+** Input bytes encoded with a code book built from their own statistics
+*/
+typedef struct
+{
+    const uint8 *Src;          /* Original symbols, used to verify the decoded output */
+    size_t       Length;       /* Number of symbols */
+    uint8 *      Enc;          /* Encoded stream */
+    size_t       EncodedBytes; /* Size of the encoded stream */
+    uint32 *     Index;        /* Bit offset of every HUFF_APP_WORKLOAD_BLOCK_SYMBOLS-th symbol */
+    size_t       IndexEntries; /* Number of blocks in the index */
+
+    uint32                 Hist[HUFF_APP_CODEC_SYMBOLS];
+    HUFF_APP_CodeBook_t    Book;
+    HUFF_APP_DecodeTable_t Table;
+
+    bool Valid;
+} HUFF_APP_Workload_t;
+
+/*
+** Timed decode of a workload
+*/
+typedef struct
+{
+    int32  Status;         /* First decode or verification failure, CFE_SUCCESS otherwise */
+    uint32 Iterations;     /* Complete decodes of the workload in the sample */
+    int64  DurationMicros; /* Elapsed time of the sample */
+    uint64 Symbols;        /* Symbols decoded in the sample */
+} HUFF_APP_DecodeResult_t;
+
+/*
+** Static buffers shared by the workloads, decoded by the benchmark executor task
+*/
+extern uint8  HUFF_APP_WorkloadSrcBuf[HUFF_APP_WORKLOAD_MAX_BYTES];
+extern uint8  HUFF_APP_WorkloadEncBuf[HUFF_APP_WORKLOAD_ENC_BYTES];
+extern uint8  HUFF_APP_WorkloadOutBuf[HUFF_APP_WORKLOAD_MAX_BYTES];
+extern uint32 HUFF_APP_WorkloadIndexBuf[HUFF_APP_WORKLOAD_INDEX_ENTRIES];
+
+int32  HUFF_APP_WorkloadPrepare(HUFF_APP_Workload_t *Workload, const uint8 *Src, size_t Length, uint8 *Enc,
+                                size_t EncSize, uint32 *Index, size_t IndexEntries);
+const HUFF_APP_Workload_t *HUFF_APP_WorkloadCurrent(void);
+int32  HUFF_APP_WorkloadDecode(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                               HUFF_APP_DecodeResult_t *Result);
+int32  HUFF_APP_WorkloadDecodeSerial(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                                     HUFF_APP_DecodeResult_t *Result);
+int32  HUFF_APP_WorkloadMeasure(const HUFF_APP_Workload_t *Workload, size_t Length, uint8 *Out,
+                                HUFF_APP_DecodeResult_t *Result);
+uint32 HUFF_APP_ResultKiloBytesPerSec(const HUFF_APP_DecodeResult_t *Result);
+uint32 HUFF_APP_ResultPicosPerSymbol(const HUFF_APP_DecodeResult_t *Result);
+
+#endif /* HUFF_APP_WORKLOAD_H */
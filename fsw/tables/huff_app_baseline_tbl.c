@@ -0,0 +1,40 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Default performance baseline table of the HUFF App.
+ *
+ *   Starts empty: baselines are recorded with the BATCH command on a
+ *   known good build, and the app has Table Services dump the table over
+ *   /cf/huff_app_baseline_tbl.tbl, which is loaded first at the next start.
+ */
+
+#include "huff_app_tbl.h"
+#include "cfe_tbl_filedef.h" /* Required to obtain the CFE_TBL_FILEDEF macro definition */
+
+HUFF_APP_BaselineTable_t HUFF_APP_BaselineDefaultTable = {.ZThresholdMilli = 3000, .MinDeltaPermille = 20};
+
+/*
+** The macro below identifies:
+**    1) the data structure type to use as the table image format
+**    2) the name of the table to be placed into the cFE Table File Header
+**    3) a brief description of the contents of the file image
+**    4) the desired name of the table image binary file that is cFE compatible
+*/
+CFE_TBL_FILEDEF(HUFF_APP_BaselineDefaultTable, HUFF_APP.BaselineTable, Huff App Baseline Table, huff_app_baseline_tbl.tbl)
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#
+# Convert a HUFF App binary trace dump (TRACE_DUMP command, format 1) into
+# Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.
+#
+# usage: huff_trace2json.py huff_trace.bin [huff_trace.json]
+#
+
+import json
+import struct
+import sys
+
+PHASES = ["receive", "dispatch", "generate", "decode", "verify", "format", "transmit"]
+VERSION = 1
+NAME_LEN = 20
+EVENT = "QBB6x"
+
+
+def read_dump(data):
+    if data[:4] != b"HUTR":
+        raise ValueError("not a HUFF App trace dump")
+
+    # The dump is in the byte order of the target, found from the version
+    for order in "<>":
+        version, ticks_per_second, rings = struct.unpack_from(order + "III", data, 4)
+        if version == VERSION:
+            break
+    else:
+        raise ValueError("unsupported trace dump version")
+
+    offset = 16
+    tasks = []
+    for _ in range(rings):
+        name = data[offset:offset + NAME_LEN].split(b"\0", 1)[0].decode("ascii", "replace")
+        (count,) = struct.unpack_from(order + "I", data, offset + NAME_LEN)
+        offset += NAME_LEN + 4
+        events = list(struct.iter_unpack(order + EVENT, data[offset:offset + count * 16]))
+        offset += count * 16
+        tasks.append((name, events))
+
+    return ticks_per_second, tasks
+
+
+def to_chrome(ticks_per_second, tasks):
+    starts = [events[0][0] for _, events in tasks if events]
+    origin = min(starts) if starts else 0
+
+    out = [{"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "HUFF_APP"}}]
+    for tid, (name, events) in enumerate(tasks, 1):
+        out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": name}})
+        depth = 0
+        for ticks, phase, kind in events:
+            if phase >= len(PHASES):
+                continue
+            # Ends of phases begun before the oldest retained event have no match
+            if kind == 1:
+                if depth == 0:
+                    continue
+                depth -= 1
+            else:
+                depth += 1
+            out.append({
+                "name": PHASES[phase],
+                "cat": "huff",
+                "ph": "E" if kind == 1 else "B",
+                "ts": max(ticks - origin, 0) * 1e6 / ticks_per_second,
+                "pid": 1,
+                "tid": tid,
+            })
+
+    return {"displayTimeUnit": "ns", "traceEvents": out}
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write("usage: %s huff_trace.bin [huff_trace.json]\n" % argv[0])
+        return 2
+
+    with open(argv[1], "rb") as f:
+        ticks_per_second, tasks = read_dump(f.read())
+
+    trace = to_chrome(ticks_per_second, tasks)
+
+    if len(argv) == 3:
+        with open(argv[2], "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
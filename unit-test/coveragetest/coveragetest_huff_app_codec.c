@@ -0,0 +1,350 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Coverage test of the HUFF App canonical Huffman codec
+ */
+
+/*
+ * Includes
+ */
+#include "huff_app_coveragetest_common.h"
+#include "huff_app_codec.h"
+
+#define UT_CODEC_SYMBOLS   20000
+#define UT_CODEC_ENC_BYTES (UT_CODEC_SYMBOLS * HUFF_APP_CODEC_MAX_CODE_LEN / 8 + 1)
+#define UT_CODEC_BLOCK     1000
+
+/*
+ * Buffers of one round trip, too large for the test stack
+ */
+static uint8                  UT_Src[UT_CODEC_SYMBOLS];
+static uint8                  UT_Enc[UT_CODEC_ENC_BYTES];
+static uint8                  UT_Out[UT_CODEC_SYMBOLS];
+static uint32                 UT_Hist[HUFF_APP_CODEC_SYMBOLS];
+static uint8                  UT_Lengths[HUFF_APP_CODEC_SYMBOLS];
+static HUFF_APP_CodeBook_t    UT_Book;
+static HUFF_APP_DecodeTable_t UT_Table;
+
+/*
+ * Deterministic pseudo-random numbers, the same on every host
+ */
+static uint32 UT_CodecRandom(uint32 *State)
+{
+    *State = *State * 1664525u + 1013904223u;
+    return *State >> 8;
+}
+
+/*
+ * Sum of 2^(MAX_CODE_LEN - length) over the used symbols, at most
+ * HUFF_APP_CODEC_TABLE_SIZE for a decodable prefix code
+ */
+static uint32 UT_CodecKraft(const uint8 *Lengths)
+{
+    uint32 Kraft = 0;
+    uint32 i;
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (Lengths[i] != 0)
+        {
+            Kraft += 1u << (HUFF_APP_CODEC_MAX_CODE_LEN - Lengths[i]);
+        }
+    }
+
+    return Kraft;
+}
+
+/*
+ * Build the book of UT_Src, encode it and return the encoded size
+ */
+static size_t UT_CodecEncodeSrc(size_t Length)
+{
+    size_t EncodedBytes = 0;
+
+    HUFF_APP_CodecHistogram(UT_Src, Length, UT_Hist);
+    HUFF_APP_CodecBuildLengths(UT_Hist, UT_Lengths);
+    UtAssert_INT32_EQ(HUFF_APP_CodecBuildCodeBook(UT_Lengths, &UT_Book), CFE_SUCCESS);
+    HUFF_APP_CodecBuildDecodeTable(&UT_Book, &UT_Table);
+
+    UtAssert_INT32_EQ(HUFF_APP_CodecEncode(&UT_Book, UT_Src, Length, UT_Enc, sizeof(UT_Enc), &EncodedBytes),
+                      CFE_SUCCESS);
+    UtAssert_True(EncodedBytes * 8 >= HUFF_APP_CodecEncodedBits(&UT_Book, UT_Hist) &&
+                      EncodedBytes * 8 < HUFF_APP_CodecEncodedBits(&UT_Book, UT_Hist) + 8,
+                  "Encoded size %lu bytes matches the histogram", (unsigned long)EncodedBytes);
+
+    return EncodedBytes;
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HUFF_APP_CodecRoundTripSkewed(void)
+{
+    /*
+     * Test Case For:
+     * Encode then decode a geometric distribution, with both decoders
+     */
+    uint32 State = 12345;
+    uint32 Value;
+    size_t EncodedBytes;
+    size_t i;
+
+    for (i = 0; i < UT_CODEC_SYMBOLS; i++)
+    {
+        /* Symbol k with probability 2^-(k+1), over the printable range */
+        Value = UT_CodecRandom(&State) | 0x80000000u;
+        for (UT_Src[i] = 'A'; (Value & 1) == 0; Value >>= 1)
+        {
+            UT_Src[i]++;
+        }
+    }
+
+    EncodedBytes = UT_CodecEncodeSrc(UT_CODEC_SYMBOLS);
+    UtAssert_True(EncodedBytes < UT_CODEC_SYMBOLS / 2, "Skewed input compresses to %lu bytes",
+                  (unsigned long)EncodedBytes);
+
+    memset(UT_Out, 0, sizeof(UT_Out));
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecode(&UT_Table, UT_Enc, EncodedBytes, UT_Out, UT_CODEC_SYMBOLS), CFE_SUCCESS);
+    UtAssert_MemCmp(UT_Out, UT_Src, UT_CODEC_SYMBOLS, "Table decode matches the input");
+
+    memset(UT_Out, 0, sizeof(UT_Out));
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeSerial(&UT_Book, UT_Enc, EncodedBytes, UT_Out, UT_CODEC_SYMBOLS),
+                      CFE_SUCCESS);
+    UtAssert_MemCmp(UT_Out, UT_Src, UT_CODEC_SYMBOLS, "Serial decode matches the input");
+}
+
+void Test_HUFF_APP_CodecRoundTripSingleSymbol(void)
+{
+    /*
+     * Test Case For:
+     * A buffer of one repeated symbol, coded on a single bit
+     */
+    size_t EncodedBytes;
+
+    memset(UT_Src, 0x5A, UT_CODEC_SYMBOLS);
+
+    EncodedBytes = UT_CodecEncodeSrc(UT_CODEC_SYMBOLS);
+    UtAssert_UINT32_EQ(UT_Lengths[0x5A], 1);
+    UtAssert_UINT32_EQ(UT_CodecKraft(UT_Lengths), HUFF_APP_CODEC_TABLE_SIZE / 2);
+    UtAssert_UINT32_EQ(EncodedBytes, (UT_CODEC_SYMBOLS + 7) / 8);
+
+    memset(UT_Out, 0, sizeof(UT_Out));
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecode(&UT_Table, UT_Enc, EncodedBytes, UT_Out, UT_CODEC_SYMBOLS), CFE_SUCCESS);
+    UtAssert_MemCmp(UT_Out, UT_Src, UT_CODEC_SYMBOLS, "Table decode matches the input");
+
+    memset(UT_Out, 0, sizeof(UT_Out));
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeSerial(&UT_Book, UT_Enc, EncodedBytes, UT_Out, UT_CODEC_SYMBOLS),
+                      CFE_SUCCESS);
+    UtAssert_MemCmp(UT_Out, UT_Src, UT_CODEC_SYMBOLS, "Serial decode matches the input");
+}
+
+void Test_HUFF_APP_CodecLengthLimit(void)
+{
+    /*
+     * Test Case For:
+     * Fibonacci weights, whose unlimited Huffman code is 29 bits deep
+     */
+    uint32 i;
+
+    memset(UT_Hist, 0, sizeof(UT_Hist));
+    UT_Hist[0] = 1;
+    UT_Hist[1] = 1;
+    for (i = 2; i < 30; i++)
+    {
+        UT_Hist[i] = UT_Hist[i - 1] + UT_Hist[i - 2];
+    }
+
+    HUFF_APP_CodecBuildLengths(UT_Hist, UT_Lengths);
+
+    for (i = 0; i < HUFF_APP_CODEC_SYMBOLS; i++)
+    {
+        if (UT_Hist[i] != 0)
+        {
+            UtAssert_True(UT_Lengths[i] >= 1 && UT_Lengths[i] <= HUFF_APP_CODEC_MAX_CODE_LEN,
+                          "Symbol %u length %u within 1..%u", (unsigned int)i, (unsigned int)UT_Lengths[i],
+                          (unsigned int)HUFF_APP_CODEC_MAX_CODE_LEN);
+        }
+        else
+        {
+            UtAssert_UINT32_EQ(UT_Lengths[i], 0);
+        }
+    }
+
+    UtAssert_True(UT_CodecKraft(UT_Lengths) <= HUFF_APP_CODEC_TABLE_SIZE, "Kraft sum %lu <= %lu",
+                  (unsigned long)UT_CodecKraft(UT_Lengths), (unsigned long)HUFF_APP_CODEC_TABLE_SIZE);
+    UtAssert_INT32_EQ(HUFF_APP_CodecBuildCodeBook(UT_Lengths, &UT_Book), CFE_SUCCESS);
+}
+
+void Test_HUFF_APP_CodecBuildCodeBookInvalid(void)
+{
+    /*
+     * Test Case For:
+     * Code lengths that no prefix code can have
+     */
+    memset(UT_Lengths, 0, sizeof(UT_Lengths));
+
+    /* Longer than the decode table */
+    UT_Lengths[0] = HUFF_APP_CODEC_MAX_CODE_LEN + 1;
+    UtAssert_INT32_EQ(HUFF_APP_CodecBuildCodeBook(UT_Lengths, &UT_Book), CFE_STATUS_VALIDATION_FAILURE);
+
+    /* Three 1-bit codes over-subscribe the code space */
+    UT_Lengths[0] = 1;
+    UT_Lengths[1] = 1;
+    UT_Lengths[2] = 1;
+    UtAssert_INT32_EQ(HUFF_APP_CodecBuildCodeBook(UT_Lengths, &UT_Book), CFE_STATUS_VALIDATION_FAILURE);
+}
+
+void Test_HUFF_APP_CodecDecodeAtBlocks(void)
+{
+    /*
+     * Test Case For:
+     * Decoding each block on its own from the bit offsets of the block index
+     */
+    uint32 Index[(UT_CODEC_SYMBOLS + UT_CODEC_BLOCK - 1) / UT_CODEC_BLOCK];
+    uint32 State = 777;
+    size_t EncodedBytes;
+    size_t Entries;
+    size_t Count;
+    size_t i;
+
+    for (i = 0; i < UT_CODEC_SYMBOLS; i++)
+    {
+        UT_Src[i] = (uint8)(UT_CodecRandom(&State) % 40);
+    }
+
+    EncodedBytes = UT_CodecEncodeSrc(UT_CODEC_SYMBOLS);
+
+    Entries = HUFF_APP_CodecBuildIndex(&UT_Book, UT_Src, UT_CODEC_SYMBOLS, UT_CODEC_BLOCK, Index,
+                                       sizeof(Index) / sizeof(Index[0]));
+    UtAssert_UINT32_EQ(Entries, sizeof(Index) / sizeof(Index[0]));
+
+    /* Blocks in reverse order, so that none relies on the state left by the previous one */
+    memset(UT_Out, 0, sizeof(UT_Out));
+    for (i = Entries; i-- > 0;)
+    {
+        Count = (i == Entries - 1) ? UT_CODEC_SYMBOLS - i * UT_CODEC_BLOCK : UT_CODEC_BLOCK;
+        UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, EncodedBytes, Index[i],
+                                                 &UT_Out[i * UT_CODEC_BLOCK], Count),
+                          CFE_SUCCESS);
+    }
+    UtAssert_MemCmp(UT_Out, UT_Src, UT_CODEC_SYMBOLS, "Block decodes match the input");
+
+    /* An index too small for the input is not built */
+    UtAssert_UINT32_EQ(HUFF_APP_CodecBuildIndex(&UT_Book, UT_Src, UT_CODEC_SYMBOLS, UT_CODEC_BLOCK, Index, 1), 0);
+    UtAssert_UINT32_EQ(HUFF_APP_CodecBuildIndex(&UT_Book, UT_Src, UT_CODEC_SYMBOLS, 0, Index, Entries), 0);
+}
+
+void Test_HUFF_APP_CodecDecodeAtTruncated(void)
+{
+    /*
+     * Test Case For:
+     * Streams shorter than the symbols asked for
+     */
+    uint32 State = 4242;
+    size_t EncodedBytes;
+    size_t i;
+
+    for (i = 0; i < UT_CODEC_SYMBOLS; i++)
+    {
+        UT_Src[i] = (uint8)(UT_CodecRandom(&State) % 200);
+    }
+
+    EncodedBytes = UT_CodecEncodeSrc(UT_CODEC_SYMBOLS);
+
+    /* Half of the stream: the rest would be decoded from the zero padding */
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, EncodedBytes / 2, 0, UT_Out, UT_CODEC_SYMBOLS),
+                      CFE_STATUS_WRONG_MSG_LENGTH);
+
+    /* All but the last byte */
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, EncodedBytes - 1, 0, UT_Out, UT_CODEC_SYMBOLS),
+                      CFE_STATUS_WRONG_MSG_LENGTH);
+
+    /* Starting past the end of the stream */
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, EncodedBytes, (uint64)EncodedBytes * 8 + 1, UT_Out,
+                                             1),
+                      CFE_STATUS_WRONG_MSG_LENGTH);
+
+    /* The serial decoder checks every bit it reads */
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeSerial(&UT_Book, UT_Enc, EncodedBytes / 2, UT_Out, UT_CODEC_SYMBOLS),
+                      CFE_STATUS_WRONG_MSG_LENGTH);
+}
+
+void Test_HUFF_APP_CodecDecodeAtGarbage(void)
+{
+    /*
+     * Test Case For:
+     * Bit patterns that are not a code of an incomplete book
+     */
+    size_t EncodedBytes;
+
+    memset(UT_Lengths, 0, sizeof(UT_Lengths));
+
+    /* Codes 0 and 10: any stream starting with 11 is invalid */
+    UT_Lengths['a'] = 1;
+    UT_Lengths['b'] = 2;
+    UtAssert_INT32_EQ(HUFF_APP_CodecBuildCodeBook(UT_Lengths, &UT_Book), CFE_SUCCESS);
+    HUFF_APP_CodecBuildDecodeTable(&UT_Book, &UT_Table);
+
+    memset(UT_Enc, 0xFF, 16);
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, 16, 0, UT_Out, 8), CFE_STATUS_VALIDATION_FAILURE);
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeSerial(&UT_Book, UT_Enc, 16, UT_Out, 8), CFE_STATUS_VALIDATION_FAILURE);
+
+    /* Valid codes first (0, 10, 0 = 0100), then garbage from bit 4 on */
+    UT_Enc[0] = 0x4F;
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, 16, 0, UT_Out, 3), CFE_SUCCESS);
+    UtAssert_MemCmp(UT_Out, "aba", 3, "Valid prefix decoded");
+    UtAssert_INT32_EQ(HUFF_APP_CodecDecodeAt(&UT_Table, UT_Enc, 16, 0, UT_Out, 4), CFE_STATUS_VALIDATION_FAILURE);
+
+    /* Symbols outside the book cannot be encoded */
+    UT_Src[0] = 'c';
+    UtAssert_INT32_EQ(HUFF_APP_CodecEncode(&UT_Book, UT_Src, 1, UT_Enc, sizeof(UT_Enc), &EncodedBytes),
+                      CFE_STATUS_VALIDATION_FAILURE);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void HUFF_APP_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void HUFF_APP_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HUFF_APP_CodecRoundTripSkewed);
+    ADD_TEST(HUFF_APP_CodecRoundTripSingleSymbol);
+    ADD_TEST(HUFF_APP_CodecLengthLimit);
+    ADD_TEST(HUFF_APP_CodecBuildCodeBookInvalid);
+    ADD_TEST(HUFF_APP_CodecDecodeAtBlocks);
+    ADD_TEST(HUFF_APP_CodecDecodeAtTruncated);
+    ADD_TEST(HUFF_APP_CodecDecodeAtGarbage);
+}
@@ -0,0 +1,379 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Coverage test of the HUFF App parallel block decode schedules
+ *
+ * Worker tasks are not started under the OSAL stubs, so the test case
+ * compiles the unit itself and runs the share of every worker in turn,
+ * through its static worker function. The decodes go through a wrapper
+ * that counts how often each block of the index is decoded.
+ */
+
+/*
+ * Includes
+ */
+#include "huff_app_coveragetest_common.h"
+#include "huff_app_codec.h"
+
+#define HUFF_APP_CodecDecodeAt UT_ParDecDecodeAt
+
+static int32 UT_ParDecDecodeAt(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes,
+                               uint64 BitOffset, uint8 *Dst, size_t NumSymbols);
+
+#include "huff_app_pardec.c"
+
+#undef HUFF_APP_CodecDecodeAt
+
+/* An odd number of blocks and a partial last block, so the ranges are uneven */
+#define UT_PARDEC_BLOCKS  (9 * HUFF_APP_PARDEC_CHUNK_BLOCKS + 1)
+#define UT_PARDEC_SYMBOLS ((UT_PARDEC_BLOCKS - 1) * HUFF_APP_WORKLOAD_BLOCK_SYMBOLS + 1000)
+#define UT_PARDEC_CHUNKS  ((UT_PARDEC_BLOCKS + HUFF_APP_PARDEC_CHUNK_BLOCKS - 1) / HUFF_APP_PARDEC_CHUNK_BLOCKS)
+
+/*
+ * Workload decoded by every test case
+ */
+static uint8               UT_ParDecSrc[UT_PARDEC_SYMBOLS];
+static uint8               UT_ParDecEnc[UT_PARDEC_SYMBOLS * HUFF_APP_CODEC_MAX_CODE_LEN / 8 + 1];
+static uint8               UT_ParDecOut[UT_PARDEC_SYMBOLS];
+static uint32              UT_ParDecIndex[UT_PARDEC_BLOCKS];
+static HUFF_APP_Workload_t UT_ParDecWorkload;
+
+/* Times each block was decoded */
+static uint32 UT_ParDecCount[UT_PARDEC_BLOCKS];
+
+/*
+ * Stand-ins for the other units of the app
+ */
+HUFF_APP_Data_t       HUFF_APP_Data;
+HUFF_APP_TraceRing_t *HUFF_APP_TraceByTask[OS_MAX_TASKS];
+uint8                 HUFF_APP_WorkloadOutBuf[HUFF_APP_WORKLOAD_MAX_BYTES];
+
+bool HUFF_APP_ExecCancelled(void)
+{
+    return false;
+}
+int64 HUFF_APP_GetTimeMicros(void)
+{
+    return 0;
+}
+uint64 HUFF_APP_GetTimebaseTicks(void)
+{
+    return 0;
+}
+void HUFF_APP_ReportInit(HUFF_APP_Report_t *Report, const char *Tag) {}
+void HUFF_APP_ReportAddU32(HUFF_APP_Report_t *Report, uint32 Value) {}
+void HUFF_APP_ReportAddHexU32(HUFF_APP_Report_t *Report, uint32 Value) {}
+void HUFF_APP_ReportAddBuildId(HUFF_APP_Report_t *Report) {}
+void HUFF_APP_ReportSend(HUFF_APP_Report_t *Report) {}
+uint32 HUFF_APP_ResultKiloBytesPerSec(const HUFF_APP_DecodeResult_t *Result)
+{
+    return 0;
+}
+void HUFF_APP_RunStatDecoded(uint64 Bytes, uint64 Symbols) {}
+void HUFF_APP_TraceAttach(const char *Name) {}
+const HUFF_APP_Workload_t *HUFF_APP_WorkloadCurrent(void)
+{
+    return &UT_ParDecWorkload;
+}
+
+/*
+ * Count the blocks a worker decodes, then decode them
+ */
+static int32 UT_ParDecDecodeAt(const HUFF_APP_DecodeTable_t *Table, const uint8 *Src, size_t SrcBytes,
+                               uint64 BitOffset, uint8 *Dst, size_t NumSymbols)
+{
+    size_t FirstSymbol = Dst - UT_ParDecOut;
+    size_t Block       = FirstSymbol / HUFF_APP_WORKLOAD_BLOCK_SYMBOLS;
+    size_t EndBlock;
+
+    EndBlock = (FirstSymbol + NumSymbols + HUFF_APP_WORKLOAD_BLOCK_SYMBOLS - 1) / HUFF_APP_WORKLOAD_BLOCK_SYMBOLS;
+
+    UtAssert_UINT32_EQ(FirstSymbol % HUFF_APP_WORKLOAD_BLOCK_SYMBOLS, 0);
+    UtAssert_UINT32_EQ(BitOffset, UT_ParDecIndex[Block]);
+
+    for (; Block < EndBlock; Block++)
+    {
+        UT_ParDecCount[Block]++;
+    }
+
+    return HUFF_APP_CodecDecodeAt(Table, Src, SrcBytes, BitOffset, Dst, NumSymbols);
+}
+
+/*
+ * Publish a job of NumWorkers workers, as HUFF_APP_ParDecDecode() does
+ */
+static void UT_ParDecSetJob(uint8 NumWorkers, HUFF_APP_ParDecSched_Enum_t Sched)
+{
+    memset(UT_ParDecOut, 0, sizeof(UT_ParDecOut));
+    memset(UT_ParDecCount, 0, sizeof(UT_ParDecCount));
+    memset(HUFF_APP_ParDecData.Worker, 0, sizeof(HUFF_APP_ParDecData.Worker));
+
+    HUFF_APP_ParDecData.Workload   = &UT_ParDecWorkload;
+    HUFF_APP_ParDecData.Out        = UT_ParDecOut;
+    HUFF_APP_ParDecData.NumWorkers = NumWorkers;
+    HUFF_APP_ParDecData.Sched      = Sched;
+}
+
+/*
+ * Every block decoded exactly once, into the original input
+ */
+static void UT_ParDecCheckJob(uint8 NumWorkers, uint32 ExpectChunks)
+{
+    uint32 Chunks = 0;
+    size_t i;
+
+    for (i = 0; i < UT_PARDEC_BLOCKS; i++)
+    {
+        UtAssert_True(UT_ParDecCount[i] == 1, "Block %lu decoded %lu times with %u workers", (unsigned long)i,
+                      (unsigned long)UT_ParDecCount[i], (unsigned int)NumWorkers);
+    }
+    for (i = 0; i < NumWorkers; i++)
+    {
+        Chunks += HUFF_APP_ParDecData.Worker[i].Chunks;
+    }
+
+    UtAssert_UINT32_EQ(Chunks, ExpectChunks);
+    UtAssert_MemCmp(UT_ParDecOut, UT_ParDecSrc, UT_PARDEC_SYMBOLS, "Decoded output matches the input");
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HUFF_APP_ParDecStatic(void)
+{
+    /*
+     * Test Case For:
+     * One contiguous range of blocks per worker, for every worker count
+     */
+    uint8 NumWorkers;
+    uint8 i;
+
+    for (NumWorkers = 1; NumWorkers <= HUFF_APP_PARDEC_MAX_WORKERS; NumWorkers++)
+    {
+        UT_ParDecSetJob(NumWorkers, HUFF_APP_ParDecSched_STATIC);
+
+        for (i = 0; i < NumWorkers; i++)
+        {
+            UtAssert_INT32_EQ(HUFF_APP_ParDecWork(i), CFE_SUCCESS);
+        }
+
+        UT_ParDecCheckJob(NumWorkers, NumWorkers);
+    }
+}
+
+void Test_HUFF_APP_ParDecStaticFewBlocks(void)
+{
+    /*
+     * Test Case For:
+     * More workers than blocks: the surplus workers get empty ranges
+     */
+    HUFF_APP_Workload_t Saved = UT_ParDecWorkload;
+    uint8               i;
+
+    UT_ParDecWorkload.Length       = HUFF_APP_WORKLOAD_BLOCK_SYMBOLS + 1;
+    UT_ParDecWorkload.IndexEntries = 2;
+
+    UT_ParDecSetJob(HUFF_APP_PARDEC_MAX_WORKERS, HUFF_APP_ParDecSched_STATIC);
+    for (i = 0; i < HUFF_APP_PARDEC_MAX_WORKERS; i++)
+    {
+        UtAssert_INT32_EQ(HUFF_APP_ParDecWork(i), CFE_SUCCESS);
+    }
+
+    UtAssert_UINT32_EQ(UT_ParDecCount[0], 1);
+    UtAssert_UINT32_EQ(UT_ParDecCount[1], 1);
+    UtAssert_UINT32_EQ(UT_ParDecCount[2], 0);
+    UtAssert_MemCmp(UT_ParDecOut, UT_ParDecSrc, HUFF_APP_WORKLOAD_BLOCK_SYMBOLS + 1, "Decoded output matches");
+
+    UT_ParDecWorkload = Saved;
+}
+
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+
+void Test_HUFF_APP_ParDecDeque(void)
+{
+    /*
+     * Test Case For:
+     * The owner takes the seeded chunks in increasing order from the bottom,
+     * a thief takes them from the top, and no chunk is handed out twice
+     */
+    HUFF_APP_ParDecDeque_t *Deque = &HUFF_APP_ParDecDeque[0];
+    int32                   Low;
+    int32                   High;
+    int32                   Chunk;
+    uint32                  Taken = 0;
+
+    UT_ParDecSetJob(1, HUFF_APP_ParDecSched_STEAL);
+    HUFF_APP_ParDecSeed();
+
+    Low  = 0;
+    High = UT_PARDEC_CHUNKS - 1;
+    while (Low <= High)
+    {
+        Chunk = HUFF_APP_ParDecTake(Deque);
+        UtAssert_INT32_EQ(Chunk, Low);
+        Low++;
+        Taken++;
+
+        if (Low <= High)
+        {
+            Chunk = HUFF_APP_ParDecSteal(Deque);
+            UtAssert_INT32_EQ(Chunk, High);
+            High--;
+            Taken++;
+        }
+    }
+
+    UtAssert_UINT32_EQ(Taken, UT_PARDEC_CHUNKS);
+    UtAssert_INT32_EQ(HUFF_APP_ParDecTake(Deque), HUFF_APP_PARDEC_EMPTY);
+    UtAssert_INT32_EQ(HUFF_APP_ParDecSteal(Deque), HUFF_APP_PARDEC_EMPTY);
+}
+
+void Test_HUFF_APP_ParDecSteal(void)
+{
+    /*
+     * Test Case For:
+     * Work stealing, with each worker in turn running first: it drains its
+     * own deque, then steals the chunks of all the others
+     */
+    uint8  NumWorkers;
+    uint8  First;
+    uint8  i;
+    uint32 Steals;
+
+    for (NumWorkers = 1; NumWorkers <= HUFF_APP_PARDEC_MAX_WORKERS; NumWorkers++)
+    {
+        for (First = 0; First < NumWorkers; First++)
+        {
+            UT_ParDecSetJob(NumWorkers, HUFF_APP_ParDecSched_STEAL);
+            HUFF_APP_ParDecSeed();
+
+            for (i = 0; i < NumWorkers; i++)
+            {
+                UtAssert_INT32_EQ(HUFF_APP_ParDecWork((First + i) % NumWorkers), CFE_SUCCESS);
+            }
+
+            UT_ParDecCheckJob(NumWorkers, UT_PARDEC_CHUNKS);
+
+            /* Everything but the first worker's own range was stolen */
+            Steals = UT_PARDEC_CHUNKS - ((UT_PARDEC_CHUNKS * (First + 1)) / NumWorkers -
+                                         (UT_PARDEC_CHUNKS * First) / NumWorkers);
+            UtAssert_UINT32_EQ(HUFF_APP_ParDecSteals(), Steals);
+        }
+    }
+}
+
+#endif
+
+void Test_HUFF_APP_ParDecDecode(void)
+{
+    /*
+     * Test Case For:
+     * A whole timed decode on the calling task, verified against the input
+     */
+    HUFF_APP_DecodeResult_t Result;
+
+    memset(UT_ParDecCount, 0, sizeof(UT_ParDecCount));
+    memset(&Result, 0, sizeof(Result));
+    Result.Iterations = 2;
+
+    /* No worker task was started, so the decode runs on one worker */
+    UtAssert_INT32_EQ(HUFF_APP_ParDecDecode(&UT_ParDecWorkload, HUFF_APP_PARDEC_MAX_WORKERS,
+                                            HUFF_APP_ParDecSched_STATIC, UT_ParDecOut, &Result),
+                      CFE_SUCCESS);
+    UtAssert_UINT32_EQ(Result.Symbols, 2 * UT_PARDEC_SYMBOLS);
+    UtAssert_UINT32_EQ(UT_ParDecCount[0], 2);
+    UtAssert_UINT32_EQ(UT_ParDecCount[UT_PARDEC_BLOCKS - 1], 2);
+
+    /* A corrupted stream fails the decode or its verification */
+    UT_ParDecEnc[UT_ParDecWorkload.EncodedBytes / 2] ^= 0x5A;
+    Result.Iterations = 1;
+    UtAssert_True(HUFF_APP_ParDecDecode(&UT_ParDecWorkload, 1, HUFF_APP_ParDecSched_STATIC, UT_ParDecOut,
+                                        &Result) != CFE_SUCCESS,
+                  "Corrupted stream rejected");
+    UT_ParDecEnc[UT_ParDecWorkload.EncodedBytes / 2] ^= 0x5A;
+}
+
+/*
+ * Setup function prior to every test
+ */
+void HUFF_APP_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void HUFF_APP_UT_TearDown(void) {}
+
+/*
+ * Encode the workload once, with the codec under its own coverage test
+ */
+static void UT_ParDecPrepare(void)
+{
+    HUFF_APP_Workload_t *Workload = &UT_ParDecWorkload;
+    uint8                Lengths[HUFF_APP_CODEC_SYMBOLS];
+    uint32               State = 2024;
+    size_t               i;
+
+    /* Runs of a few symbols, so blocks decode at different speeds */
+    for (i = 0; i < UT_PARDEC_SYMBOLS; i++)
+    {
+        State           = State * 1664525u + 1013904223u;
+        UT_ParDecSrc[i]    = (uint8)((i / 5000) % 3 == 0 ? (State >> 24) : (State >> 29));
+    }
+
+    memset(Workload, 0, sizeof(*Workload));
+    Workload->Src    = UT_ParDecSrc;
+    Workload->Length = UT_PARDEC_SYMBOLS;
+    Workload->Enc    = UT_ParDecEnc;
+    Workload->Index  = UT_ParDecIndex;
+
+    HUFF_APP_CodecHistogram(UT_ParDecSrc, UT_PARDEC_SYMBOLS, Workload->Hist);
+    HUFF_APP_CodecBuildLengths(Workload->Hist, Lengths);
+    HUFF_APP_CodecBuildCodeBook(Lengths, &Workload->Book);
+    HUFF_APP_CodecBuildDecodeTable(&Workload->Book, &Workload->Table);
+    HUFF_APP_CodecEncode(&Workload->Book, UT_ParDecSrc, UT_PARDEC_SYMBOLS, UT_ParDecEnc, sizeof(UT_ParDecEnc),
+                         &Workload->EncodedBytes);
+    Workload->IndexEntries = HUFF_APP_CodecBuildIndex(&Workload->Book, UT_ParDecSrc, UT_PARDEC_SYMBOLS,
+                                                      HUFF_APP_WORKLOAD_BLOCK_SYMBOLS, UT_ParDecIndex,
+                                                      UT_PARDEC_BLOCKS);
+    Workload->Valid        = true;
+}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    UT_ParDecPrepare();
+
+    ADD_TEST(HUFF_APP_ParDecStatic);
+    ADD_TEST(HUFF_APP_ParDecStaticFewBlocks);
+#ifdef HUFF_APP_PARDEC_STEAL_SUPPORTED
+    ADD_TEST(HUFF_APP_ParDecDeque);
+    ADD_TEST(HUFF_APP_ParDecSteal);
+#endif
+    ADD_TEST(HUFF_APP_ParDecDecode);
+}